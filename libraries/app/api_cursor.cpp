@@ -0,0 +1,26 @@
+#include <futurepia/app/api_cursor.hpp>
+
+#include <fc/crypto/base64.hpp>
+#include <fc/exception/exception.hpp>
+#include <fc/io/json.hpp>
+
+namespace futurepia { namespace app {
+
+std::string encode_cursor( const api_cursor& c )
+{
+   return fc::base64_encode( fc::json::to_string( c ) );
+}
+
+api_cursor decode_cursor( const std::string& cursor, const std::string& index )
+{ try {
+   auto c = fc::json::from_string( fc::base64_decode( cursor ) ).as< api_cursor >();
+   FC_ASSERT( c.index == index, "Cursor was issued for another query" );
+   return c;
+} FC_CAPTURE_AND_RETHROW( (cursor)(index) ) }
+
+bool cursor_keys_equal( const fc::variants& a, const fc::variants& b )
+{
+   return fc::json::to_string( a ) == fc::json::to_string( b );
+}
+
+} } // futurepia::app
@@ -0,0 +1,270 @@
+#include <futurepia/app/api_response_cache.hpp>
+#include <futurepia/app/application.hpp>
+#include <futurepia/app/impacted.hpp>
+
+#include <fc/thread/scoped_lock.hpp>
+
+namespace futurepia { namespace app {
+
+using namespace futurepia::protocol;
+
+struct cache_view_visitor
+{
+   typedef uint32_t result_type;
+
+   template< typename T >
+   uint32_t operator()( const T& )const { return 0; }
+
+   uint32_t operator()( const comment_operation& )const { return api_response_cache::content_view; }
+   uint32_t operator()( const comment_vote_operation& )const { return api_response_cache::content_view; }
+   uint32_t operator()( const comment_betting_operation& )const { return api_response_cache::content_view; }
+   uint32_t operator()( const comment_betting_state_operation& )const { return api_response_cache::content_view; }
+   uint32_t operator()( const delete_comment_operation& )const { return api_response_cache::content_view; }
+
+   uint32_t operator()( const custom_json_operation& )const { return api_response_cache::content_view | api_response_cache::dapp_view; }
+   uint32_t operator()( const custom_json_hf2_operation& )const { return api_response_cache::content_view | api_response_cache::dapp_view; }
+   uint32_t operator()( const custom_binary_operation& )const { return api_response_cache::content_view | api_response_cache::dapp_view; }
+
+   uint32_t operator()( const bobserver_update_operation& )const { return api_response_cache::bobserver_view; }
+   uint32_t operator()( const account_bobserver_vote_operation& )const { return api_response_cache::bobserver_view; }
+   uint32_t operator()( const account_bproducer_appointment_operation& )const { return api_response_cache::bobserver_view; }
+   uint32_t operator()( const except_bobserver_operation& )const { return api_response_cache::bobserver_view; }
+   uint32_t operator()( const shutdown_bobserver_operation& )const { return api_response_cache::bobserver_view; }
+   uint32_t operator()( const decline_voting_rights_operation& )const { return api_response_cache::bobserver_view; }
+};
+
+api_response_cache::api_response_cache( chain::database& db, uint32_t max_entries )
+   : _db( db ), _max_entries( max_entries ) {}
+
+void api_response_cache::connect()
+{
+   _post_apply_operation_conn = connect_signal( _db.post_apply_operation, *this, &api_response_cache::on_post_apply_operation );
+   _applied_block_conn = connect_signal( _db.applied_block, *this, &api_response_cache::on_applied_block );
+   _pending_transaction_conn = connect_signal( _db.on_pending_transaction, *this, &api_response_cache::on_pending_transaction );
+   _session_conn = connect_signal( _db.get_session_signal()->on_session, *this, &api_response_cache::on_session );
+}
+
+optional< state > api_response_cache::find_state( const string& path )
+{
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   auto itr = _entries.find( "state:" + path );
+   if( itr == _entries.end() || !itr->second.state_result.valid() )
+      return optional< state >();
+   return itr->second.state_result;
+}
+
+void api_response_cache::store_state( const string& path, const state& s, uint32_t flags )
+{
+   cache_entry entry;
+   entry.state_result = s;
+   entry.flags = flags;
+   for( const auto& a : s.accounts )
+      entry.accounts.insert( a.first );
+
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   insert( "state:" + path, std::move( entry ) );
+}
+
+optional< vector< discussion > > api_response_cache::find_discussions( const string& key )
+{
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   auto itr = _entries.find( "discussion:" + key );
+   if( itr == _entries.end() || !itr->second.discussion_result.valid() )
+      return optional< vector< discussion > >();
+   return itr->second.discussion_result;
+}
+
+void api_response_cache::store_discussions( const string& key, const vector< discussion >& d )
+{
+   cache_entry entry;
+   entry.discussion_result = d;
+   entry.flags = content_view;
+
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   insert( "discussion:" + key, std::move( entry ) );
+}
+
+bool api_response_cache::fill_globals( state& s )
+{
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   if( !_globals_valid )
+      return false;
+
+   s.props = _props;
+   s.bobserver_schedule = _bobserver_schedule;
+   return true;
+}
+
+void api_response_cache::update_globals()
+{
+   dynamic_global_property_api_obj props( _db.get_dynamic_global_properties(), _db );
+   bobserver_schedule_api_obj schedule = _db.get_bobserver_schedule_object();
+
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   _props = props;
+   _bobserver_schedule = schedule;
+   _globals_valid = true;
+}
+
+void api_response_cache::clear()
+{
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   clear_unlocked();
+}
+
+void api_response_cache::on_post_apply_operation( const operation_notification& note )
+{
+   dirty_set dirty;
+   dirty.flags = note.op.visit( cache_view_visitor() );
+
+   fc::flat_set< account_name_type > impacted;
+   operation_get_impacted_accounts( note.op, _db, impacted );
+   dirty.accounts.insert( impacted.begin(), impacted.end() );
+
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   _globals_valid = false;
+   invalidate( dirty );
+
+   _pending_dirty.flags |= dirty.flags;
+   _pending_dirty.accounts.insert( dirty.accounts.begin(), dirty.accounts.end() );
+}
+
+void api_response_cache::on_applied_block( const chain::signed_block& b )
+{
+   {
+      fc::scoped_lock< boost::mutex > lock( _mutex );
+
+      // A block that does not build on the last one we saw means we switched forks
+      if( _head_block_id != chain::block_id_type() && b.previous != _head_block_id )
+         clear_unlocked();
+
+      // Bobserver miss counters and confirmations change on every block
+      dirty_set dirty;
+      dirty.flags = bobserver_view;
+      invalidate( dirty );
+
+      _pending_dirty.clear();
+      _head_block_id = _db.head_block_id();
+   }
+
+   update_globals();
+}
+
+void api_response_cache::on_pending_transaction( const chain::signed_transaction& trx )
+{
+   update_globals();
+}
+
+void api_response_cache::on_session( const chainbase::session_signal::session_state session_state, const int64_t revision )
+{
+   if( session_state != chainbase::session_signal::session_state::undo )
+      return;
+
+   fc::scoped_lock< boost::mutex > lock( _mutex );
+   _globals_valid = false;
+
+   if( revision == ALL_SESSION_CODE )
+   {
+      // pop_block() or undo_all(), state went back past the last applied block
+      clear_unlocked();
+      _head_block_id = chain::block_id_type();
+      return;
+   }
+
+   invalidate( _pending_dirty );
+}
+
+void api_response_cache::insert( const string& key, cache_entry&& entry )
+{
+   if( _max_entries == 0 )
+      return;
+
+   erase( key );
+
+   // _insert_order also holds keys of entries that were invalidated or replaced, those are skipped by sequence
+   while( _insert_order.size() && ( _entries.size() >= _max_entries || _insert_order.size() > 2 * _max_entries ) )
+   {
+      auto itr = _entries.find( _insert_order.front().second );
+      if( itr != _entries.end() && itr->second.sequence == _insert_order.front().first )
+         erase( string( itr->first ) );
+      _insert_order.pop_front();
+   }
+
+   for( uint32_t flag = content_view; flag <= dapp_view; flag <<= 1 )
+   {
+      if( entry.flags & flag )
+         _flag_refs[ flag ].insert( key );
+   }
+
+   for( const auto& a : entry.accounts )
+      _account_refs[ a ].insert( key );
+
+   entry.sequence = ++_next_sequence;
+   _insert_order.emplace_back( entry.sequence, key );
+   _entries.emplace( key, std::move( entry ) );
+}
+
+void api_response_cache::erase( const string& key )
+{
+   auto itr = _entries.find( key );
+   if( itr == _entries.end() )
+      return;
+
+   for( uint32_t flag = content_view; flag <= dapp_view; flag <<= 1 )
+   {
+      if( itr->second.flags & flag )
+         _flag_refs[ flag ].erase( key );
+   }
+
+   for( const auto& a : itr->second.accounts )
+   {
+      auto ref_itr = _account_refs.find( a );
+      if( ref_itr == _account_refs.end() )
+         continue;
+
+      ref_itr->second.erase( key );
+      if( ref_itr->second.empty() )
+         _account_refs.erase( ref_itr );
+   }
+
+   _entries.erase( itr );
+}
+
+void api_response_cache::invalidate( const dirty_set& dirty )
+{
+   std::set< string > keys;
+
+   for( uint32_t flag = content_view; flag <= dapp_view; flag <<= 1 )
+   {
+      if( !( dirty.flags & flag ) )
+         continue;
+
+      auto ref_itr = _flag_refs.find( flag );
+      if( ref_itr != _flag_refs.end() )
+         keys.insert( ref_itr->second.begin(), ref_itr->second.end() );
+   }
+
+   for( const auto& a : dirty.accounts )
+   {
+      auto ref_itr = _account_refs.find( a );
+      if( ref_itr != _account_refs.end() )
+         keys.insert( ref_itr->second.begin(), ref_itr->second.end() );
+   }
+
+   for( const auto& key : keys )
+      erase( key );
+
+   if( _entries.empty() )
+      _insert_order.clear();
+}
+
+void api_response_cache::clear_unlocked()
+{
+   _entries.clear();
+   _insert_order.clear();
+   _flag_refs.clear();
+   _account_refs.clear();
+   _pending_dirty.clear();
+}
+
+} } // futurepia::app
@@ -23,6 +23,7 @@
  */
 #include <futurepia/app/api.hpp>
 #include <futurepia/app/api_access.hpp>
+#include <futurepia/app/api_response_cache.hpp>
 #include <futurepia/app/application.hpp>
 #include <futurepia/app/plugin.hpp>
 
@@ -272,6 +273,25 @@ namespace detail {
          else
             _shared_dir = _data_dir / "blockchain";
 
+         uint32_t map_flags = chainbase::database::map_default;
+         if( _options->count("shared-file-map") )
+         {
+            for( const auto& mode : _options->at("shared-file-map").as< vector< string > >() )
+            {
+               if( mode == "hugepage" )
+                  map_flags |= chainbase::database::map_hugepage;
+               else if( mode == "random" )
+                  map_flags |= chainbase::database::map_random;
+               else if( mode == "willneed" )
+                  map_flags |= chainbase::database::map_willneed;
+               else if( mode == "populate" )
+                  map_flags |= chainbase::database::map_populate;
+               else
+                  FC_THROW( "Unknown shared-file-map mode ${m}", ("m", mode) );
+            }
+         }
+         _chain_db->set_map_options( map_flags, _options->at("shared-file-numa-node").as< int32_t >() );
+
          if( _options->count( "disable_get_block" ) )
             _self->_disable_get_block = true;
 
@@ -285,6 +305,12 @@ namespace detail {
                _chain_db->wipe(_data_dir / "blockchain", _shared_dir, true);
 
             _chain_db->set_flush_interval( _options->at("flush").as<uint32_t>() );
+            _chain_db->set_block_log_queue_size( _options->at("block-log-queue-size").as<uint32_t>() );
+            _chain_db->set_transaction_check_threads( _options->at("transaction-check-threads").as<uint32_t>() );
+            _chain_db->set_block_operations_depth( _options->at("block-operations-depth").as<uint32_t>() );
+            _chain_db->set_custom_operation_cache_size( _options->at("custom-op-cache-size").as<uint32_t>() );
+            _chain_db->set_shared_file_growth( _options->at("shared-file-full-threshold").as<uint16_t>(),
+                                               _options->at("shared-file-scale-rate").as<uint16_t>() );
 
             flat_map<uint32_t,block_id_type> loaded_checkpoints;
             if( _options->count("checkpoint") )
@@ -351,6 +377,15 @@ namespace detail {
          }
          _chain_db->show_free_memory( true );
 
+         // A read-only process does not see the writer's signals, so it could never invalidate the cache
+         uint32_t response_cache_size = _options->at( "api-response-cache-size" ).as< uint32_t >();
+         if( !read_only && response_cache_size > 0 )
+         {
+            _response_cache = std::make_shared< api_response_cache >( *_chain_db, response_cache_size );
+            _response_cache->connect();
+            ilog( "API response cache enabled, ${n} entries", ("n", response_cache_size) );
+         }
+
          if( _options->count("api-user") )
          {
             for( const std::string& api_access_str : _options->at("api-user").as< std::vector<std::string> >() )
@@ -917,6 +952,7 @@ namespace detail {
       std::shared_ptr<graphene::net::node>             _p2p_network;
       std::shared_ptr<fc::http::websocket_server>      _websocket_server;
       std::shared_ptr<fc::http::websocket_tls_server>  _websocket_tls_server;
+      std::shared_ptr< api_response_cache >            _response_cache;
 
       std::map<string, std::shared_ptr<abstract_plugin> > _plugins_available;
       std::map<string, std::shared_ptr<abstract_plugin> > _plugins_enabled;
@@ -978,6 +1014,7 @@ void application::set_program_options(boost::program_options::options_descriptio
    default_plugins.push_back( "dapp" );
    default_plugins.push_back( "token" );
    default_plugins.push_back( "dapp_history" );
+   default_plugins.push_back( "account_rank" );
    std::string str_default_plugins = boost::algorithm::join( default_plugins, " " );
 
    configuration_file_options.add_options()
@@ -987,6 +1024,10 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("checkpoint,c", bpo::value<vector<string>>()->composing(), "Pairs of [BLOCK_NUM,BLOCK_ID] that should be enforced as checkpoints.")
          ("shared-file-dir", bpo::value<string>(), "Location of the shared memory file. Defaults to data_dir/blockchain")
          ("shared-file-size", bpo::value<string>()->default_value("10G"), "Size of the shared memory file. Default: 10G")
+         ("shared-file-map", bpo::value< vector<string> >()->composing(), "How to map the shared memory file: hugepage, random, willneed or populate. May be specified multiple times. Huge pages need shared-file-dir on hugetlbfs or on tmpfs with shmem huge pages enabled")
+         ("shared-file-numa-node", bpo::value< int32_t >()->default_value(-1), "NUMA node to bind the pages of a tmpfs or hugetlbfs shared memory file to, -1 for no binding")
+         ("shared-file-full-threshold", bpo::value<uint16_t>()->default_value(0), "Percentage of the shared memory file in use, times 100, at which it is grown without a restart. 0 disables growing")
+         ("shared-file-scale-rate", bpo::value<uint16_t>()->default_value(0), "Percentage of its size, times 100, the shared memory file grows by when it reaches shared-file-full-threshold. 0 disables growing")
          ("rpc-endpoint", bpo::value<string>()->default_value("0.0.0.0:15021"), "Endpoint for websocket RPC to listen on")
          ("rpc-tls-endpoint", bpo::value<string>()->implicit_value("127.0.0.1:8089"), "Endpoint for TLS websocket RPC to listen on")
          ("read-forward-rpc", bpo::value<string>(), "Endpoint to forward write API calls to for a read node" )
@@ -997,7 +1038,12 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("enable-plugin", bpo::value< vector<string> >()->composing()->default_value(default_plugins, str_default_plugins), "Plugin(s) to enable, may be specified multiple times")
          ("max-block-age", bpo::value< int32_t >()->default_value(200), "Maximum age of head block when broadcasting tx via API")
          ("flush", bpo::value< uint32_t >()->default_value(100000), "Flush shared memory file to disk this many blocks")
+         ("block-log-queue-size", bpo::value< uint32_t >()->default_value(1000), "Irreversible blocks buffered for the background block log writer, 0 to write them synchronously")
+         ("transaction-check-threads", bpo::value< uint32_t >()->default_value(0), "Threads validating and recovering signatures of block transactions before they are applied, 0 to check them inline")
+         ("block-operations-depth", bpo::value< uint32_t >()->default_value(FUTUREPIA_BLOCKS_PER_DAY), "Recent blocks whose operations are kept in a flat table for get_ops_in_block, a second copy of each operation in shared memory. 0 disables the table")
+         ("custom-op-cache-size", bpo::value< uint32_t >()->default_value(10000), "Parsed plugin operations of custom_json and custom_binary operations cached by each plugin, 0 to disable")
          ("backtrace", bpo::value<string>()->default_value("yes"), "Whether to print backtrace on SIGSEGV")
+         ("api-response-cache-size", bpo::value< uint32_t >()->default_value(1000), "Number of get_state/get_discussions_by_* responses cached between blocks, 0 to disable")
          ;
    command_line_options.add(configuration_file_options);
    command_line_options.add_options()
@@ -1051,6 +1097,16 @@ std::shared_ptr<chain::database> application::chain_database() const
 {
    return my->_chain_db;
 }
+std::shared_ptr< api_response_cache > application::get_api_response_cache() const
+{
+   return my->_response_cache;
+}
+
+const fc::path& application::data_dir() const
+{
+   return my->_data_dir;
+}
+
 /*std::shared_ptr<graphene::db::object_database> application::pending_trx_database() const
 {
    return my->_pending_trx_db;
@@ -1,7 +1,10 @@
 #include <futurepia/app/api_context.hpp>
+#include <futurepia/app/api_response_cache.hpp>
 #include <futurepia/app/application.hpp>
 #include <futurepia/app/database_api.hpp>
 
+#include <futurepia/account_rank/account_rank_plugin.hpp>
+
 #include <futurepia/protocol/get_config.hpp>
 
 #include <futurepia/chain/util/reward.hpp>
@@ -15,6 +18,7 @@
 
 
 #include <cctype>
+#include <numeric>
 
 #include <cfenv>
 #include <iostream>
@@ -74,6 +78,13 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
       bool verify_authority( const signed_transaction& trx )const;
       bool verify_account_authority( const string& name_or_id, const flat_set<public_key_type>& signers )const;
 
+      // Batch
+      fc::variant batch_call_entry( const batch_call_request& call )const;
+
+      // Response cache
+      vector< discussion > get_cached_discussions( const string& method, const discussion_query& query,
+                                                   const std::function< vector< discussion >() >& fetch );
+
       // signal handlers
       void on_applied_block( const chain::signed_block& b );
 
@@ -87,6 +98,10 @@ class database_api_impl : public std::enable_shared_from_this<database_api_impl>
 
       std::shared_ptr< futurepia::dapp::dapp_api > _dapp_api;
 
+      std::shared_ptr< api_response_cache > _cache;
+
+      std::shared_ptr< futurepia::account_rank::account_rank_plugin > _account_rank;
+
 };
 
 applied_operation::applied_operation() {}
@@ -103,6 +118,17 @@ applied_operation::applied_operation( const operation_object& op_obj )
    op = fc::raw::unpack< operation >( op_obj.serialized_op );
 }
 
+/**
+ * Positions of names in ascending order, so that a batch of lookups walks the by_name index in key order
+ */
+static vector< size_t > sorted_name_order( const vector< string >& names )
+{
+   vector< size_t > order( names.size() );
+   std::iota( order.begin(), order.end(), 0 );
+   std::sort( order.begin(), order.end(), [&]( size_t l, size_t r ) { return names[l] < names[r]; } );
+   return order;
+}
+
 void find_accounts( set<string>& accounts, const discussion& d ) {
    accounts.insert( d.author );
 }
@@ -156,6 +182,7 @@ database_api_impl::database_api_impl( const futurepia::app::api_context& ctx )
    wlog("creating database api ${x}", ("x",int64_t(this)) );
 
    _disable_get_block = ctx.app._disable_get_block;
+   _cache = ctx.app.get_api_response_cache();
 
    try
    {
@@ -163,6 +190,12 @@ database_api_impl::database_api_impl( const futurepia::app::api_context& ctx )
       _dapp_api = std::make_shared< futurepia::dapp::dapp_api >(ctx);
    }
    catch (fc::assert_exception) { ilog("dapp Pugin not loaded"); }
+
+   try
+   {
+      _account_rank = ctx.app.get_plugin< futurepia::account_rank::account_rank_plugin >( ACCOUNT_RANK_PLUGIN_NAME );
+   }
+   catch (fc::assert_exception) { ilog("account_rank Plugin not loaded"); }
 }
 
 database_api_impl::~database_api_impl()
@@ -221,15 +254,46 @@ vector<applied_operation> database_api::get_ops_in_block(uint32_t block_num, boo
 
 vector<applied_operation> database_api_impl::get_ops_in_block(uint32_t block_num, bool only_virtual)const
 {
+   const auto* block_ops = _db.find< block_operations_object, by_block >( block_num );
+   if( block_ops != nullptr )
+   {
+      vector<applied_operation> result;
+      result.reserve( block_ops->size() );
+      for( uint32_t i = 0; i < block_ops->size(); ++i )
+      {
+         if( only_virtual && !block_ops->is_virtual( i ) )
+            continue;
+
+         fc::datastream< const char* > ds( block_ops->packed_ops.data() + block_ops->offsets[i], block_ops->offsets[i+1] - block_ops->offsets[i] );
+         block_operation_header header;
+         fc::raw::unpack( ds, header );
+
+         applied_operation temp;
+         temp.trx_id       = header.trx_id;
+         temp.block        = block_num;
+         temp.trx_in_block = header.trx_in_block;
+         temp.op_in_trx    = header.op_in_trx;
+         temp.virtual_op   = header.virtual_op;
+         temp.timestamp    = header.timestamp;
+         fc::raw::unpack( ds, temp.op );
+         result.push_back( std::move( temp ) );
+      }
+      return result;
+   }
+
+   // The block is the head block, its table was pruned or it was applied before the table existed
    const auto& idx = _db.get_index< operation_index >().indices().get< by_location >();
    auto itr = idx.lower_bound( block_num );
    vector<applied_operation> result;
    applied_operation temp;
    while( itr != idx.end() && itr->block == block_num )
    {
-      temp = *itr;
-      if( !only_virtual || is_virtual_operation(temp.op) )
+      // only virtual operations carry a virtual_op sequence, skip the others before unpacking them
+      if( !only_virtual || itr->virtual_op )
+      {
+         temp = *itr;
          result.push_back(temp);
+      }
       ++itr;
    }
    return result;
@@ -255,6 +319,30 @@ fc::variant_object database_api_impl::get_config()const
    return futurepia::protocol::get_config();
 }
 
+flat_map< string, chain::custom_operation_cache_stats > database_api::get_custom_operation_cache_stats()const
+{
+   return my->_db.with_read_lock( [&]()
+   {
+      return my->_db.get_custom_operation_cache_stats();
+   });
+}
+
+id_hash_stats database_api::get_last_block_id_hash_stats()const
+{
+   return my->_db.with_read_lock( [&]()
+   {
+      return my->_db.get_last_block_id_hash_stats();
+   });
+}
+
+fc::variant database_api::decode_custom_binary_operation( const custom_binary_operation& op )const
+{
+   // Interpreters are registered at startup and decoding reads no chain state, no lock needed
+   auto interpreter = my->_db.get_custom_evaluator( op.id );
+   FC_ASSERT( interpreter, "No plugin handles custom operations with id ${id}", ("id", op.id) );
+   return interpreter->unpack_binary_operation( op );
+}
+
 dynamic_global_property_api_obj database_api::get_dynamic_global_properties()const
 {
    return my->_db.with_read_lock( [&]()
@@ -362,23 +450,31 @@ vector< extended_account > database_api_impl::get_accounts( vector< string > nam
 {
    const auto& idx  = _db.get_index< account_index >().indices().get< by_name >();
    const auto& vidx = _db.get_index< bobserver_vote_index >().indices().get< by_account_bobserver >();
-   vector< extended_account > results;
+   vector< optional< extended_account > > found( names.size() );
 
-   for( auto name: names )
+   for( auto i : sorted_name_order( names ) )
    {
-      auto itr = idx.find( name );
+      auto itr = idx.find( names[i] );
       if ( itr != idx.end() )
       {
-         results.push_back( extended_account( *itr, _db ) );
+         found[i] = extended_account( *itr, _db );
 
          auto vitr = vidx.lower_bound( boost::make_tuple( itr->id, bobserver_id_type() ) );
          while( vitr != vidx.end() && vitr->account == itr->id ) {
-            results.back().bobserver_votes.insert(_db.get(vitr->bobserver).account);
+            found[i]->bobserver_votes.insert(_db.get(vitr->bobserver).account);
             ++vitr;
          }
       }
    }
 
+   vector< extended_account > results;
+   results.reserve( names.size() );
+   for( auto& a : found )
+   {
+      if( a.valid() )
+         results.push_back( std::move( *a ) );
+   }
+
    return results;
 }
 
@@ -417,20 +513,15 @@ vector<optional<account_api_obj>> database_api::lookup_account_names(const vecto
 
 vector<optional<account_api_obj>> database_api_impl::lookup_account_names(const vector<string>& account_names)const
 {
-   vector<optional<account_api_obj> > result;
-   result.reserve(account_names.size());
+   vector<optional<account_api_obj> > result( account_names.size() );
 
-   for( auto& name : account_names )
+   for( auto i : sorted_name_order( account_names ) )
    {
-      auto itr = _db.find< account_object, by_name >( name );
+      auto itr = _db.find< account_object, by_name >( account_names[i] );
 
       if( itr )
       {
-         result.push_back( account_api_obj( *itr, _db ) );
-      }
-      else
-      {
-         result.push_back( optional< account_api_obj>() );
+         result[i] = account_api_obj( *itr, _db );
       }
    }
 
@@ -461,6 +552,36 @@ set<string> database_api_impl::lookup_accounts(const string& lower_bound_name, u
    return result;
 }
 
+paged_result< string > database_api::lookup_accounts_paged( const string& lower_bound_name, const string& cursor, uint32_t limit )const
+{
+   return my->_db.with_read_lock( [&]()
+   {
+      FC_ASSERT( limit <= 1000 );
+      const auto& idx = my->_db.get_index< account_index >().indices().get< by_name >();
+      auto key_of = []( const account_object& a ) { return fc::variants{ fc::variant( a.name ) }; };
+
+      auto itr = idx.lower_bound( lower_bound_name );
+      if( cursor.size() )
+      {
+         itr = seek_cursor< account_object >( my->_db, idx, decode_cursor( cursor, "accounts.by_name" ), key_of,
+            [&]( const fc::variants& key ) { return idx.upper_bound( key.at( 0 ).as< account_name_type >() ); } );
+      }
+
+      paged_result< string > result;
+      const account_object* last = nullptr;
+      for( ; itr != idx.end() && result.items.size() < limit; ++itr )
+      {
+         result.items.push_back( itr->name );
+         last = &*itr;
+      }
+
+      if( itr != idx.end() && last != nullptr )
+         result.next_cursor = encode_cursor( api_cursor{ "accounts.by_name", uint64_t( last->id._id ), key_of( *last ) } );
+
+      return result;
+   });
+}
+
 uint64_t database_api::get_account_count()const
 {
    return my->_db.with_read_lock( [&]()
@@ -519,13 +640,11 @@ vector< account_balance_api_obj > database_api::get_pia_rank( int limit ) const
 vector< account_balance_api_obj > database_api_impl::get_pia_rank( int limit ) const {
    FC_ASSERT( limit <= 1000 );
 
+   FC_ASSERT( _account_rank, "account_rank plugin is not enabled" );
+
    vector< account_balance_api_obj > results;
-   const auto& idx = _db.get_index< account_index >().indices().get< by_pia_balance >();
-   auto itr = idx.begin();
-   while( itr != idx.end() && limit--) {
-      results.emplace_back( account_balance_api_obj( itr->name, itr->balance) );
-      itr++;
-   }
+   for( const auto& entry : _account_rank->get_pia_rank( std::max( limit, 0 ) ) )
+      results.emplace_back( account_balance_api_obj( entry.account, entry.balance ) );
 
    return results;
 }
@@ -539,13 +658,11 @@ vector< account_balance_api_obj > database_api::get_snac_rank( int limit ) const
 vector< account_balance_api_obj > database_api_impl::get_snac_rank( int limit ) const {
    FC_ASSERT( limit <= 1000 );
 
+   FC_ASSERT( _account_rank, "account_rank plugin is not enabled" );
+
    vector< account_balance_api_obj > results;
-   const auto& idx = _db.get_index< account_index >().indices().get< by_snac_balance >();
-   auto itr = idx.begin();
-   while( itr != idx.end() && limit--) {
-      results.emplace_back( account_balance_api_obj( itr->name, itr->snac_balance ) );
-      itr++;
-   }
+   for( const auto& entry : _account_rank->get_snac_rank( std::max( limit, 0 ) ) )
+      results.emplace_back( account_balance_api_obj( entry.account, entry.balance ) );
 
    return results;
 }
@@ -709,6 +826,94 @@ bool database_api_impl::has_hardfork( uint32_t hardfork )const
    return _db.has_hardfork(hardfork);
 }
 
+//////////////////////////////////////////////////////////////////////
+//                                                                  //
+// Batch                                                            //
+//                                                                  //
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+   const size_t max_batch_calls = 100;
+}
+
+vector< batch_call_reply > database_api::batch_call( const vector< batch_call_request >& calls )const
+{
+   FC_ASSERT( calls.size() <= max_batch_calls, "batch_call takes at most ${n} calls", ("n", max_batch_calls) );
+
+   vector< batch_call_reply > replies( calls.size() );
+
+   // The impl lookups take no lock of their own, so the whole batch holds the read lock exactly once
+   my->_db.with_read_lock( [&]()
+   {
+      for( size_t i = 0; i < calls.size(); ++i )
+      {
+         try
+         {
+            replies[i].result = my->batch_call_entry( calls[i] );
+         }
+         catch( const fc::exception& e )
+         {
+            replies[i].error = e.to_detail_string();
+         }
+         catch( const std::exception& e )
+         {
+            replies[i].error = string( e.what() );
+         }
+      }
+   });
+
+   return replies;
+}
+
+fc::variant database_api_impl::batch_call_entry( const batch_call_request& call )const
+{
+   auto arg = [&]( size_t i ) -> const fc::variant&
+   {
+      FC_ASSERT( i < call.params.size(), "${m} is missing argument ${i}", ("m", call.method)("i", i) );
+      return call.params[i];
+   };
+
+   const string& m = call.method;
+
+   if( m == "get_block_header" || m == "get_block" )
+      FC_ASSERT( !_disable_get_block, "${m} is disabled on this node.", ("m", m) );
+
+   if( m == "get_block_header" )
+      return fc::variant( get_block_header( arg(0).as< uint32_t >() ) );
+   if( m == "get_block" )
+      return fc::variant( get_block( arg(0).as< uint32_t >() ) );
+   if( m == "get_ops_in_block" )
+      return fc::variant( get_ops_in_block( arg(0).as< uint32_t >(), arg(1).as_bool() ) );
+   if( m == "get_config" )
+      return fc::variant( get_config() );
+   if( m == "get_dynamic_global_properties" )
+      return fc::variant( get_dynamic_global_properties() );
+   if( m == "get_key_references" )
+      return fc::variant( get_key_references( arg(0).as< vector< public_key_type > >() ) );
+   if( m == "get_accounts" )
+      return fc::variant( get_accounts( arg(0).as< vector< string > >() ) );
+   if( m == "lookup_account_names" )
+      return fc::variant( lookup_account_names( arg(0).as< vector< string > >() ) );
+   if( m == "lookup_accounts" )
+      return fc::variant( lookup_accounts( arg(0).as_string(), arg(1).as< uint32_t >() ) );
+   if( m == "get_account_count" )
+      return fc::variant( get_account_count() );
+   if( m == "get_bobservers" )
+      return fc::variant( get_bobservers( arg(0).as< vector< bobserver_id_type > >() ) );
+   if( m == "get_bobserver_by_account" )
+      return fc::variant( get_bobserver_by_account( arg(0).as_string() ) );
+   if( m == "lookup_bobserver_accounts" )
+      return fc::variant( lookup_bobserver_accounts( arg(0).as_string(), arg(1).as< uint32_t >() ) );
+   if( m == "lookup_bproducer_accounts" )
+      return fc::variant( lookup_bproducer_accounts( arg(0).as_string(), arg(1).as< uint32_t >() ) );
+   if( m == "get_bobserver_count" )
+      return fc::variant( get_bobserver_count() );
+   if( m == "has_hardfork" )
+      return fc::variant( has_hardfork( arg(0).as< uint32_t >() ) );
+
+   FC_ASSERT( false, "${m} cannot be called through batch_call", ("m", m) );
+}
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // Authority / validation                                           //
@@ -1090,6 +1295,26 @@ vector< operation > database_api::get_history_by_opname( string account, string
    });
 }
 
+vector< discussion > database_api_impl::get_cached_discussions( const string& method, const discussion_query& query,
+                                                                const std::function< vector< discussion >() >& fetch )
+{
+   if( !_cache )
+      return _db.with_read_lock( [&]() { return fetch(); } );
+
+   string key = method + ":" + fc::json::to_string( query );
+   auto cached = _cache->find_discussions( key );
+   if( cached.valid() )
+      return *cached;
+
+   return _db.with_read_lock( [&]()
+   {
+      auto result = fetch();
+      // stored under the read lock so that no block can be applied in between
+      _cache->store_discussions( key, result );
+      return result;
+   });
+}
+
 discussion database_api::get_discussion( comment_id_type id, uint32_t truncate_body )const
 {
    discussion d = my->_db.get(id);
@@ -1163,6 +1388,29 @@ vector< discussion > database_api::get_discussions( const discussion_query& quer
    return result;
 }
 
+template< typename Index, typename KeyOf, typename UpperBound >
+paged_result< discussion > database_api::get_discussions_page( const discussion_query& query, const string& cursor,
+                                                               const string& index_name, const Index& comment_idx,
+                                                               typename Index::const_iterator comment_itr,
+                                                               KeyOf key_of, UpperBound upper_bound,
+                                                               const std::function< bool( const comment_api_obj& ) >& exit
+                                                             )const
+{
+   if( cursor.size() )
+      comment_itr = seek_cursor< comment_object >( my->_db, comment_idx, decode_cursor( cursor, index_name ), key_of, upper_bound );
+
+   paged_result< discussion > result;
+   result.items = get_discussions( query, comment_idx, comment_itr, []( const comment_api_obj& c ){ return c.is_blocked; }, exit );
+
+   if( result.items.size() && result.items.size() == query.limit )
+   {
+      const auto& last = my->_db.get< comment_object >( result.items.back().id );
+      result.next_cursor = encode_cursor( api_cursor{ index_name, uint64_t( last.id._id ), key_of( last ) } );
+   }
+
+   return result;
+}
+
 template<typename Index, typename StartItr>
 vector< discussion > database_api::get_tag_discussions( const discussion_query& query,
                                                       const Index& tidx, 
@@ -1269,7 +1517,7 @@ vector< discussion > database_api::get_discussions_by_tag( const discussion_quer
 
    auto tag = query.tag ? *( query.tag ) : "";
 
-   return my->_db.with_read_lock( [&]()
+   return my->get_cached_discussions( "get_discussions_by_tag", query, [&]()
    {
       const auto &tag_idx = my->_db.get_index< tags::tag_index >().indices().get< tags::by_tag_name >();
       auto tag_itr = tag_idx.find( tag );
@@ -1289,7 +1537,7 @@ vector< discussion > database_api::get_discussions_by_tag( const discussion_quer
 
 vector< discussion > database_api::get_discussions_by_created( const discussion_query& query )const
 {
-   return my->_db.with_read_lock( [&]()
+   return my->get_cached_discussions( "get_discussions_by_created", query, [&]()
    {
       auto parent_author = query.parent_author ? *( query.parent_author ) : "";
 
@@ -1311,9 +1559,54 @@ vector< discussion > database_api::get_discussions_by_created( const discussion_
    });
 }
 
-vector< discussion > database_api::get_replies_by_author( const discussion_query& query )const
+paged_result< discussion > database_api::get_discussions_by_created_paged( const discussion_query& query, const string& cursor )const
 {
    return my->_db.with_read_lock( [&]()
+   {
+      auto parent_author = query.parent_author ? *( query.parent_author ) : "";
+
+      // the cursor replaces start_author/start_permlink, which would re-seek through by_permlink
+      discussion_query q = query;
+      q.start_author.reset();
+      q.start_permlink.reset();
+
+      if( query.group_id < 0 )
+      {
+         const auto& created_idx = my->_db.get_index< comment_index >().indices().get< by_created >();
+         return get_discussions_page( q, cursor, "comments.by_created", created_idx, created_idx.lower_bound( parent_author ),
+            []( const comment_object& c )
+            {
+               return fc::variants{ fc::variant( c.parent_author ), fc::variant( c.created ), fc::variant( c.id._id ) };
+            },
+            [&]( const fc::variants& key )
+            {
+               return created_idx.upper_bound( boost::make_tuple( key.at( 0 ).as< account_name_type >(),
+                  key.at( 1 ).as< time_point_sec >(), comment_id_type( key.at( 2 ).as_int64() ) ) );
+            },
+            exit_default );
+      }
+      else
+      {
+         const auto& created_idx = my->_db.get_index< comment_index >().indices().get< by_group_id_created >();
+         return get_discussions_page( q, cursor, "comments.by_group_id_created", created_idx,
+            created_idx.lower_bound( boost::make_tuple( query.group_id, parent_author ) ),
+            []( const comment_object& c )
+            {
+               return fc::variants{ fc::variant( c.group_id ), fc::variant( c.parent_author ), fc::variant( c.created ), fc::variant( c.id._id ) };
+            },
+            [&]( const fc::variants& key )
+            {
+               return created_idx.upper_bound( boost::make_tuple( int32_t( key.at( 0 ).as_int64() ), key.at( 1 ).as< account_name_type >(),
+                  key.at( 2 ).as< time_point_sec >(), comment_id_type( key.at( 3 ).as_int64() ) ) );
+            },
+            [ &query ]( const comment_api_obj& c ){ return c.group_id != query.group_id; } );
+      }
+   });
+}
+
+vector< discussion > database_api::get_replies_by_author( const discussion_query& query )const
+{
+   return my->get_cached_discussions( "get_replies_by_author", query, [&]()
    {
       auto start_author = query.start_author ? *( query.start_author ) : "";
 
@@ -1332,7 +1625,7 @@ vector< discussion > database_api::get_replies_by_author( const discussion_query
 
 vector<discussion> database_api::get_blocked_discussions( const discussion_query& query ) const
 {
-   return my->_db.with_read_lock( [&]()
+   return my->get_cached_discussions( "get_blocked_discussions", query, [&]()
    {
       dlog( "get_blocked_discussions " );
 
@@ -1582,12 +1875,32 @@ vector< exchange_withdraw_api_obj > database_api::get_exchange_withdraw_list( ui
 
 state database_api::get_state( string path )const
 {
+   if( my->_cache )
+   {
+      auto cached = my->_cache->find_state( path );
+      if( cached.valid() )
+      {
+         if( !my->_cache->fill_globals( *cached ) )
+         {
+            my->_db.with_read_lock( [&]()
+            {
+               my->_cache->update_globals();
+               my->_cache->fill_globals( *cached );
+            });
+         }
+         return *cached;
+      }
+   }
+
    return my->_db.with_read_lock( [&]()
    {
       state _state;
       _state.props         = get_dynamic_global_properties();
       _state.current_route = path;
 
+      bool cacheable = true;
+      uint32_t cache_views = 0;
+
       try {
       if( path.size() && path[0] == '/' )
          path = path.substr(1); /// remove '/' from front
@@ -1642,6 +1955,7 @@ state database_api::get_state( string path )const
                }
             }
          } else if( part[1] == "recent-replies" ) {
+            cache_views |= api_response_cache::content_view;
             auto replies = get_replies_by_last_update( acnt, "", "", 50 );
             eacnt.recent_replies = vector<string>();
             for( const auto& reply : replies ) {
@@ -1652,6 +1966,7 @@ state database_api::get_state( string path )const
          }
          else if( part[1] == "posts" || part[1] == "comments" )
          {
+            cache_views |= api_response_cache::content_view;
 #ifndef IS_LOW_MEM
             int count = 0;
             const auto& pidx = my->_db.get_index<comment_index>().indices().get<by_author_last_update>();
@@ -1682,6 +1997,7 @@ state database_api::get_state( string path )const
 
          auto key = account +"/" + slug;
          auto dis = get_content( account, slug );
+         cache_views |= api_response_cache::content_view;
 
          if(dis.author.size() > 0 && dis.permlink.size() > 0) {
             recursively_fetch_content( _state, dis, accounts );
@@ -1689,12 +2005,14 @@ state database_api::get_state( string path )const
          }
       }
       else if( part[0] == "bobservers" || part[0] == "~bobservers") {
+         cache_views |= api_response_cache::bobserver_view;
          auto wits = get_bobservers_by_vote( "", 50 );
          for( const auto& w : wits ) {
             _state.bobservers[w.account] = w;
          }
       }
       else if( part[0] == "created"  ) {
+         cache_views |= api_response_cache::content_view;
          discussion_query q;
          q.limit = 20;
          q.truncate_body = 1024;
@@ -1710,6 +2028,7 @@ state database_api::get_state( string path )const
          }
       }
       else if( part[0] == "recent"  ) {
+         cache_views |= api_response_cache::content_view;
          discussion_query q;
          q.limit = 20;
          q.truncate_body = 1024;
@@ -1725,6 +2044,7 @@ state database_api::get_state( string path )const
          }
       }
       else if( part[0] == "dapp_post" ) {
+         cache_views |= api_response_cache::dapp_view;
          auto dappname = part[1];
          auto account  = part[2];
          auto permlink = part[3];         
@@ -1745,6 +2065,7 @@ state database_api::get_state( string path )const
       else {
          elog( "What... no matches" );
          _state.error = "No matches path... path = " + path;
+         cacheable = false;
       }
 
       for( const auto& a : accounts )
@@ -1762,6 +2083,9 @@ state database_api::get_state( string path )const
 
       _state.bobserver_schedule = my->_db.get_bobserver_schedule_object();
 
+      if( my->_cache && cacheable )
+         my->_cache->store_state( _state.current_route, _state, cache_views );
+
    } catch ( const fc::exception& e ) {
       _state.error = e.to_detail_string();
    }
@@ -29,6 +29,8 @@
 
 #include <futurepia/app/impacted.hpp>
 
+#include <futurepia/dapp/dapp_plugin.hpp>
+
 #include <fc/utility.hpp>
 
 namespace futurepia { namespace app {
@@ -330,10 +332,15 @@ void get_impacted_account_from_custom( const custom_json_operation& op, flat_set
 }
 
 void get_impacted_account_from_custom( const custom_binary_operation& op, flat_set< account_name_type >& result ) {
-   process_inner_operation< dapp_operation >( op.data, get_account_visitor_from_custom( result ) );
-   process_inner_operation< token_operation >( op.data, get_account_visitor_from_custom( result ) );
-   process_inner_operation< private_message_plugin_operation >( op.data, get_account_visitor_from_custom( result ) );
-   process_inner_operation< bobserver_plugin_operation >( op.data, get_account_visitor_from_custom( result ) );
+   // Packed data carries no type names, bytes of one plugin can unpack as operations of another. Only the plugin named by id is tried.
+   if( op.id == DAPP_PLUGIN_NAME )
+      process_inner_operation< dapp_operation >( op.data, get_account_visitor_from_custom( result ) );
+   else if( op.id == TOKEN_PLUGIN_NAME )
+      process_inner_operation< token_operation >( op.data, get_account_visitor_from_custom( result ) );
+   else if( op.id == "private_message" )
+      process_inner_operation< private_message_plugin_operation >( op.data, get_account_visitor_from_custom( result ) );
+   else if( op.id == "bobserver" )
+      process_inner_operation< bobserver_plugin_operation >( op.data, get_account_visitor_from_custom( result ) );
 }
 
 // template<>
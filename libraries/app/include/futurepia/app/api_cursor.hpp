@@ -0,0 +1,70 @@
+#pragma once
+#include <chainbase/chainbase.hpp>
+
+#include <fc/optional.hpp>
+#include <fc/reflect/reflect.hpp>
+#include <fc/reflect/variant.hpp>
+#include <fc/variant.hpp>
+
+#include <string>
+#include <vector>
+
+namespace futurepia { namespace app {
+
+/**
+ *  Position in a paged result set, handed to clients as an opaque string.
+ *
+ *  A cursor names the index it walks, the id of the last object returned and the key of that object in the
+ *  index. The next page starts right after the object, which is found by id and projected onto the index with
+ *  iterator_to, so every page costs the same no matter how deep it is. If the object was removed or its key
+ *  changed in the meantime, the page resumes from the upper bound of the stored key.
+ */
+struct api_cursor
+{
+   api_cursor() {}
+   api_cursor( const std::string& i, uint64_t object_id, const fc::variants& k )
+      : index( i ), id( object_id ), key( k ) {}
+
+   std::string    index;
+   uint64_t       id = 0;
+   fc::variants   key;
+};
+
+template< typename T >
+struct paged_result
+{
+   std::vector< T >              items;
+   fc::optional< std::string >   next_cursor;   ///< not set once the last page was returned
+};
+
+std::string encode_cursor( const api_cursor& c );
+
+/// Throws if the cursor is malformed or was issued for another index
+api_cursor decode_cursor( const std::string& cursor, const std::string& index );
+
+bool cursor_keys_equal( const fc::variants& a, const fc::variants& b );
+
+/**
+ *  Returns the iterator to the first object after the cursor.
+ *
+ *  @param key_of      cursor key of an object of the index
+ *  @param upper_bound iterator after a cursor key, used when the cursor object is gone
+ */
+template< typename ObjectType, typename Index, typename KeyOf, typename UpperBound >
+typename Index::const_iterator seek_cursor( const chainbase::database& db, const Index& idx, const api_cursor& c,
+                                            KeyOf&& key_of, UpperBound&& upper_bound )
+{
+   const auto* obj = db.find< ObjectType >( typename ObjectType::id_type( c.id ) );
+   if( obj != nullptr && cursor_keys_equal( key_of( *obj ), c.key ) )
+   {
+      auto itr = idx.iterator_to( *obj );
+      return ++itr;
+   }
+
+   return upper_bound( c.key );
+}
+
+} } // futurepia::app
+
+FC_REFLECT( futurepia::app::api_cursor, (index)(id)(key) )
+FC_REFLECT_TEMPLATE( (typename T), futurepia::app::paged_result<T>, (items)(next_cursor) )
@@ -0,0 +1,119 @@
+#pragma once
+#include <futurepia/app/state.hpp>
+
+#include <futurepia/chain/database.hpp>
+#include <futurepia/chain/operation_notification.hpp>
+
+#include <fc/optional.hpp>
+
+#include <boost/signals2.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+
+namespace futurepia { namespace app {
+
+using std::string;
+using std::vector;
+using futurepia::chain::operation_notification;
+using futurepia::protocol::account_name_type;
+
+/**
+ *  Response cache shared by every database_api session.
+ *
+ *  Entries hold the result of get_state and get_discussions_by_* calls. Each entry records the views it
+ *  was built from (content, bobservers, dapp content and the accounts it embeds) and is dropped as soon
+ *  as an operation touches one of those views. Entries are stored while the caller still holds the chain
+ *  read lock and invalidated from the chain signals, which run under the write lock, so a hit is always
+ *  consistent with the current head and can be served without taking the read lock again.
+ *
+ *  The dynamic global properties and bobserver schedule embedded in a state change on every block, so they
+ *  are kept as a separate snapshot and patched into cached states on the way out.
+ */
+class api_response_cache : public std::enable_shared_from_this< api_response_cache >
+{
+   public:
+      enum view_flags
+      {
+         content_view   = 1 << 0,   ///< comments, votes, bettings and tags
+         bobserver_view = 1 << 1,   ///< bobserver list and votes
+         dapp_view      = 1 << 2    ///< dapp contents, carried by custom operations
+      };
+
+      api_response_cache( chain::database& db, uint32_t max_entries );
+
+      /// Subscribes to the chain signals. Must be called once the database is open.
+      void connect();
+
+      optional< state > find_state( const string& path );
+      void store_state( const string& path, const state& s, uint32_t flags );
+
+      optional< vector< discussion > > find_discussions( const string& key );
+      void store_discussions( const string& key, const vector< discussion >& d );
+
+      /**
+       *  Copies the global snapshot into a cached state.
+       *  @return false if the snapshot is stale, the caller then has to call update_globals() under the read lock
+       */
+      bool fill_globals( state& s );
+      /// Requires the read lock
+      void update_globals();
+
+      void clear();
+
+   private:
+      struct cache_entry
+      {
+         optional< state >                   state_result;
+         optional< vector< discussion > >    discussion_result;
+         uint32_t                            flags = 0;
+         std::set< account_name_type >       accounts;
+         uint64_t                            sequence = 0;
+      };
+
+      struct dirty_set
+      {
+         uint32_t                            flags = 0;
+         std::set< account_name_type >       accounts;
+
+         void clear() { flags = 0; accounts.clear(); }
+      };
+
+      void on_post_apply_operation( const operation_notification& note );
+      void on_applied_block( const chain::signed_block& b );
+      void on_pending_transaction( const chain::signed_transaction& trx );
+      void on_session( const chainbase::session_signal::session_state state, const int64_t revision );
+
+      void insert( const string& key, cache_entry&& entry );
+      void erase( const string& key );
+      void invalidate( const dirty_set& dirty );
+      void clear_unlocked();
+
+      chain::database&                                _db;
+      uint32_t                                        _max_entries;
+
+      boost::mutex                                    _mutex;
+      std::map< string, cache_entry >                 _entries;
+      std::deque< std::pair< uint64_t, string > >     _insert_order;
+      uint64_t                                        _next_sequence = 0;
+      std::map< uint32_t, std::set< string > >        _flag_refs;
+      std::map< account_name_type, std::set< string > > _account_refs;
+
+      /// Views touched since the last applied block, invalidated again if the pending state is undone
+      dirty_set                                       _pending_dirty;
+      chain::block_id_type                            _head_block_id;
+
+      bool                                            _globals_valid = false;
+      dynamic_global_property_api_obj                 _props;
+      bobserver_schedule_api_obj                      _bobserver_schedule;
+
+      boost::signals2::scoped_connection              _post_apply_operation_conn;
+      boost::signals2::scoped_connection              _applied_block_conn;
+      boost::signals2::scoped_connection              _pending_transaction_conn;
+      boost::signals2::scoped_connection              _session_conn;
+};
+
+} } // futurepia::app
@@ -45,6 +45,7 @@ namespace futurepia { namespace app {
 
    class network_broadcast_api;
    class login_api;
+   class api_response_cache;
 
    class application
    {
@@ -84,6 +85,8 @@ namespace futurepia { namespace app {
 
          graphene::net::node_ptr                    p2p_node();
          std::shared_ptr<chain::database> chain_database()const;
+         std::shared_ptr< api_response_cache > get_api_response_cache()const;
+         const fc::path& data_dir()const;
          //std::shared_ptr<graphene::db::object_database> pending_trx_database() const;
 
          void set_block_production(bool producing_blocks);
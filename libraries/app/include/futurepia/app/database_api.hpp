@@ -1,7 +1,9 @@
 #pragma once
+#include <futurepia/app/api_cursor.hpp>
 #include <futurepia/app/applied_operation.hpp>
 #include <futurepia/app/state.hpp>
 
+#include <futurepia/chain/custom_operation_interpreter.hpp>
 #include <futurepia/chain/database.hpp>
 #include <futurepia/chain/futurepia_objects.hpp>
 #include <futurepia/chain/futurepia_object_types.hpp>
@@ -43,6 +45,20 @@ struct scheduled_hardfork
 
 class database_api_impl;
 
+/// One lookup of database_api::batch_call, a database_api method name and its arguments
+struct batch_call_request
+{
+   string         method;
+   fc::variants   params;
+};
+
+/// Reply to one batch_call_request, result is set if the lookup succeeded and error otherwise
+struct batch_call_reply
+{
+   optional< fc::variant >   result;
+   optional< string >        error;
+};
+
 /**
  *  Defines the arguments to a query as a struct so it can be easily extended
  */
@@ -137,6 +153,22 @@ class database_api
       scheduled_hardfork               get_next_scheduled_hardfork()const;
       common_fund_api_obj              get_common_fund( string name )const;
 
+      /**
+       * @brief Hits and misses of the parsed custom operation cache, by custom operation id
+       */
+      flat_map< string, chain::custom_operation_cache_stats > get_custom_operation_cache_stats()const;
+
+      /**
+       * @brief Block and transaction ids hashed while the head block was pushed
+       */
+      id_hash_stats get_last_block_id_hash_stats()const;
+
+      /**
+       * @brief Decode the inner operations of a custom_binary_operation, for display
+       * @param op packed operation, its id selects the plugin that decodes it
+       */
+      fc::variant decode_custom_binary_operation( const custom_binary_operation& op )const;
+
       //fund
       dapp_reward_fund_api_object      get_dapp_reward_fund() const;
 
@@ -174,6 +206,14 @@ class database_api
        */
       set<string> lookup_accounts(const string& lower_bound_name, uint32_t limit)const;
 
+      /**
+       * @brief Same as lookup_accounts, paged with an opaque cursor
+       * @param lower_bound_name Lower bound of the first name to return, ignored when a cursor is given
+       * @param cursor next_cursor of the previous page, empty for the first page
+       * @param limit Maximum number of results to return -- must not exceed 1000
+       */
+      paged_result< string > lookup_accounts_paged( const string& lower_bound_name, const string& cursor, uint32_t limit )const;
+
       /**
        * @brief Get the total number of accounts registered with the blockchain
        */
@@ -241,6 +281,20 @@ class database_api
       
       bool has_hardfork( uint32_t hardfork )const;
 
+      ///////////
+      // Batch //
+      ///////////
+
+      /**
+       * @brief Runs several lookups under a single acquisition of the chain read lock, so they all see the same block
+       * @param calls Up to 100 calls of get_block_header, get_block, get_ops_in_block, get_config,
+       *        get_dynamic_global_properties, get_key_references, get_accounts, lookup_account_names, lookup_accounts,
+       *        get_account_count, get_bobservers, get_bobserver_by_account, lookup_bobserver_accounts,
+       *        lookup_bproducer_accounts, get_bobserver_count or has_hardfork
+       * @return One reply per call in the same order, a call that fails does not stop the others
+       */
+      vector< batch_call_reply > batch_call( const vector< batch_call_request >& calls )const;
+
       ////////////////////////////
       // Authority / validation //
       ////////////////////////////
@@ -331,6 +385,12 @@ class database_api
        * */
       vector<discussion> get_discussions_by_created( const discussion_query& query )const;
 
+      /**
+       * Same as get_discussions_by_created, paged with an opaque cursor instead of start_author/start_permlink.
+       * @param cursor next_cursor of the previous page, empty for the first page
+       * */
+      paged_result< discussion > get_discussions_by_created_paged( const discussion_query& query, const string& cursor )const;
+
       /**
        * get replies by author in the latest update time order
        * @param query searching conditions. use start_author in discussion_query. (@see discussion_query)
@@ -381,15 +441,15 @@ class database_api
       vector< operation > get_history_by_opname( string account, string op_name )const; 
 
       /**
-       * get PIA rank list
-       * @param limit Maximum number of results to return -- must not exceed 1000
+       * get PIA rank list, requires the account_rank plugin
+       * @param limit Maximum number of results to return -- must not exceed 1000 nor account-rank-size
        * @return PIA rank list. If some accounts has same PIA balance, is displayed accounts in the order of registration.
        */
       vector< account_balance_api_obj > get_pia_rank( int limit ) const;
 
       /**
-       * get SNAC rank list
-       * @param limit Maximum number of results to return -- must not exceed 1000
+       * get SNAC rank list, requires the account_rank plugin
+       * @param limit Maximum number of results to return -- must not exceed 1000 nor account-rank-size
        * @return SNAC rank list. If some accounts has same SNAC balance, is displayed accounts in the order of registration.
        */
       vector< account_balance_api_obj > get_snac_rank( int limit ) const;
@@ -415,6 +475,14 @@ class database_api
                                           bool ignore_parent = false
                                         )const;
 
+      template< typename Index, typename KeyOf, typename UpperBound >
+      paged_result< discussion > get_discussions_page( const discussion_query& query, const string& cursor,
+                                                       const string& index_name, const Index& comment_idx,
+                                                       typename Index::const_iterator comment_itr,
+                                                       KeyOf key_of, UpperBound upper_bound,
+                                                       const std::function< bool( const comment_api_obj& ) >& exit
+                                                     )const;
+
       template<typename Index, typename StartItr>
       vector<discussion> get_tag_discussions( const discussion_query& q,
                                              const Index& idx, 
@@ -435,6 +503,8 @@ class database_api
 } }
 
 FC_REFLECT( futurepia::app::scheduled_hardfork, (hf_version)(live_time) );
+FC_REFLECT( futurepia::app::batch_call_request, (method)(params) )
+FC_REFLECT( futurepia::app::batch_call_reply, (result)(error) )
 
 FC_REFLECT( futurepia::app::discussion_query, 
    (tag)
@@ -452,6 +522,7 @@ FC_API(futurepia::app::database_api,
    (set_block_applied_callback)
 
    (get_discussions_by_created)
+   (get_discussions_by_created_paged)
    (get_replies_by_author)
    (get_blocked_discussions)
 
@@ -471,6 +542,9 @@ FC_API(futurepia::app::database_api,
    (get_hardfork_version)
    (get_next_scheduled_hardfork)
    (get_common_fund)
+   (get_custom_operation_cache_stats)
+   (get_last_block_id_hash_stats)
+   (decode_custom_binary_operation)
    //fund
    (get_dapp_reward_fund)
 
@@ -482,6 +556,7 @@ FC_API(futurepia::app::database_api,
    (get_account_references)
    (lookup_account_names)
    (lookup_accounts)
+   (lookup_accounts_paged)
    (get_account_count)
    (get_account_history)
    (get_history_by_opname) 
@@ -535,4 +610,7 @@ FC_API(futurepia::app::database_api,
    (get_active_bobservers)
    (lookup_bproducer_accounts)
    (has_hardfork)
+
+   // Batch
+   (batch_call)
 )
@@ -1,6 +1,19 @@
 #include <futurepia/chain/block_log.hpp>
 #include <fstream>
 #include <fc/io/raw.hpp>
+#include <fc/thread/scoped_lock.hpp>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <atomic>
+#include <deque>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define LOG_READ  (std::ios::in | std::ios::binary)
 #define LOG_WRITE (std::ios::out | std::ios::binary | std::ios::app)
@@ -18,6 +31,37 @@ namespace futurepia { namespace chain {
             fc::path                 index_file;
             bool                     block_write = false;
             bool                     index_write = false;
+            uint32_t                 file_head_num = 0;
+
+            /// Guards the streams, taken by readers and by the writer thread
+            boost::mutex             io_mutex;
+
+            /// Blocks appended but not yet persisted, ordered by block number
+            std::deque< std::shared_ptr< const signed_block > > queue;
+            size_t                   max_queue_size = 0;
+            boost::mutex             queue_mutex;
+            boost::condition_variable queue_cv;    ///< signalled when blocks are queued or the writer should stop
+            boost::condition_variable space_cv;    ///< signalled when a batch has been persisted
+            bool                     stopping = false;
+            std::string              writer_error;
+            boost::thread            writer;
+
+            std::atomic< uint32_t >  persisted_num{ 0 };
+
+            int                      block_fd = -1;
+            int                      index_fd = -1;
+
+            void sync_files()
+            {
+               block_stream.flush();
+               index_stream.flush();
+#ifndef WIN32
+               if( block_fd >= 0 )
+                  ::fsync( block_fd );
+               if( index_fd >= 0 )
+                  ::fsync( index_fd );
+#endif
+            }
 
             inline void check_block_read()
             {
@@ -92,6 +136,7 @@ namespace futurepia { namespace chain {
 
    block_log::~block_log()
    {
+      stop_writer();
       flush();
    }
 
@@ -136,6 +181,8 @@ namespace futurepia { namespace chain {
          ilog( "Log is nonempty" );
          my->head = read_head();
          my->head_id = my->head->id();
+         my->file_head_num = my->head->block_num();
+         my->persisted_num = my->file_head_num;
 
          if( index_size )
          {
@@ -180,6 +227,7 @@ namespace futurepia { namespace chain {
 
    void block_log::close()
    {
+      stop_writer();
       my.reset( new detail::block_log_impl() );
    }
 
@@ -189,34 +237,203 @@ namespace futurepia { namespace chain {
    }
 
    uint64_t block_log::append( const signed_block& b )
+   {
+      return append( b, b.id() );
+   }
+
+   uint64_t block_log::append( const signed_block& b, const block_id_type& id )
+   {
+      try
+      {
+         if( !has_writer() )
+         {
+            fc::scoped_lock< boost::mutex > lock( my->io_mutex );
+            uint64_t pos = my->block_stream.tellp();
+            write_block( b );
+            my->head = b;
+            my->head_id = id;
+            return pos;
+         }
+
+         return append( std::make_shared< const signed_block >( b ), id );
+      }
+      FC_LOG_AND_RETHROW()
+   }
+
+   uint64_t block_log::append( const std::shared_ptr< const signed_block >& block, const block_id_type& id )
    {
       try
       {
-         my->check_block_write();
-         my->check_index_write();
-
-         uint64_t pos = my->block_stream.tellp();
-         uint64_t index_pos = my->index_stream.tellp();
-         FC_ASSERT( index_pos == sizeof( uint64_t ) * uint64_t( b.block_num() - 1 ), "Append to index file occuring at wrong position.", ( "position", (uint64_t) my->index_stream.tellp() )( "expected",( b.block_num() - 1 ) * sizeof( uint64_t ) ) );
-         auto data = fc::raw::pack( b );
-         my->block_stream.write( data.data(), data.size() );
-         my->block_stream.write( (char*)&pos, sizeof( pos ) );
-         my->index_stream.write( (char*)&pos, sizeof( pos ) );
+         const signed_block& b = *block;
+         if( !has_writer() )
+            return append( b, id );
+
+         uint32_t head_num = my->head.valid() ? my->head->block_num() : 0;
+         FC_ASSERT( b.block_num() == head_num + 1, "Append to block log occuring at wrong block number.", ("block_num", b.block_num())("expected", head_num + 1) );
+
+         {
+            boost::unique_lock< boost::mutex > lock( my->queue_mutex );
+            my->space_cv.wait( lock, [&]() { return my->queue.size() < my->max_queue_size || !my->writer_error.empty(); } );
+            FC_ASSERT( my->writer_error.empty(), "Block log writer failed: ${e}", ("e", my->writer_error) );
+            my->queue.push_back( block );
+         }
+         my->queue_cv.notify_one();
+
          my->head = b;
-         my->head_id = b.id();
+         my->head_id = id;
 
-         return pos;
+         // The file position is only known once the writer gets to the block
+         return npos;
       }
       FC_LOG_AND_RETHROW()
    }
 
+   void block_log::write_block( const signed_block& b )
+   {
+      my->check_block_write();
+      my->check_index_write();
+
+      uint64_t pos = my->block_stream.tellp();
+      uint64_t index_pos = my->index_stream.tellp();
+      FC_ASSERT( index_pos == sizeof( uint64_t ) * uint64_t( b.block_num() - 1 ), "Append to index file occuring at wrong position.", ( "position", (uint64_t) my->index_stream.tellp() )( "expected",( b.block_num() - 1 ) * sizeof( uint64_t ) ) );
+      auto data = fc::raw::pack( b );
+      my->block_stream.write( data.data(), data.size() );
+      my->block_stream.write( (char*)&pos, sizeof( pos ) );
+      my->index_stream.write( (char*)&pos, sizeof( pos ) );
+      my->file_head_num = b.block_num();
+   }
+
    void block_log::flush()
    {
+      if( has_writer() )
+      {
+         boost::unique_lock< boost::mutex > lock( my->queue_mutex );
+         my->space_cv.wait( lock, [&]() { return my->queue.empty() || !my->writer_error.empty(); } );
+         FC_ASSERT( my->writer_error.empty(), "Block log writer failed: ${e}", ("e", my->writer_error) );
+         return;
+      }
+
+      fc::scoped_lock< boost::mutex > lock( my->io_mutex );
       my->block_stream.flush();
       my->index_stream.flush();
+      my->persisted_num = my->file_head_num;
+   }
+
+   void block_log::start_writer( size_t max_queue_size )
+   {
+      FC_ASSERT( is_open(), "Block log must be open before starting the writer" );
+      FC_ASSERT( max_queue_size > 0 );
+      FC_ASSERT( !has_writer(), "Block log writer is already running" );
+
+      flush();
+
+#ifndef WIN32
+      my->block_fd = ::open( my->block_file.generic_string().c_str(), O_RDONLY );
+      my->index_fd = ::open( my->index_file.generic_string().c_str(), O_RDONLY );
+#endif
+
+      my->max_queue_size = max_queue_size;
+      my->stopping = false;
+      my->writer_error.clear();
+      my->writer = boost::thread( [this]() { writer_loop(); } );
+   }
+
+   void block_log::stop_writer()
+   {
+      if( !has_writer() )
+         return;
+
+      {
+         fc::scoped_lock< boost::mutex > lock( my->queue_mutex );
+         my->stopping = true;
+      }
+      my->queue_cv.notify_all();
+      my->writer.join();
+
+      if( !my->writer_error.empty() )
+         elog( "Block log writer stopped with ${n} unwritten blocks: ${e}", ("n", my->queue.size())("e", my->writer_error) );
+
+#ifndef WIN32
+      if( my->block_fd >= 0 )
+         ::close( my->block_fd );
+      if( my->index_fd >= 0 )
+         ::close( my->index_fd );
+#endif
+      my->block_fd = -1;
+      my->index_fd = -1;
+   }
+
+   bool block_log::has_writer()const
+   {
+      return my->writer.joinable();
+   }
+
+   uint32_t block_log::persisted_block_num()const
+   {
+      return my->persisted_num;
+   }
+
+   void block_log::writer_loop()
+   {
+      std::vector< std::shared_ptr< const signed_block > > batch;
+
+      while( true )
+      {
+         batch.clear();
+         {
+            boost::unique_lock< boost::mutex > lock( my->queue_mutex );
+            my->queue_cv.wait( lock, [&]() { return my->stopping || !my->queue.empty(); } );
+            if( my->queue.empty() )
+               return;
+
+            // Blocks stay in the queue until they are on disk so readers can still find them
+            batch.assign( my->queue.begin(), my->queue.end() );
+         }
+
+         try
+         {
+            fc::scoped_lock< boost::mutex > lock( my->io_mutex );
+            for( const auto& b : batch )
+               write_block( *b );
+            my->sync_files();
+         }
+         catch( const fc::exception& e )
+         {
+            fc::scoped_lock< boost::mutex > lock( my->queue_mutex );
+            my->writer_error = e.to_detail_string();
+         }
+         catch( const std::exception& e )
+         {
+            fc::scoped_lock< boost::mutex > lock( my->queue_mutex );
+            my->writer_error = e.what();
+         }
+
+         {
+            fc::scoped_lock< boost::mutex > lock( my->queue_mutex );
+            if( my->writer_error.empty() )
+            {
+               my->queue.erase( my->queue.begin(), my->queue.begin() + batch.size() );
+               my->persisted_num = batch.back()->block_num();
+            }
+         }
+         my->space_cv.notify_all();
+
+         if( !my->writer_error.empty() )
+            return;
+      }
    }
 
    std::pair< signed_block, uint64_t > block_log::read_block( uint64_t pos )const
+   {
+      try
+      {
+         fc::scoped_lock< boost::mutex > lock( my->io_mutex );
+         return read_block_unlocked( pos );
+      }
+      FC_LOG_AND_RETHROW()
+   }
+
+   std::pair< signed_block, uint64_t > block_log::read_block_unlocked( uint64_t pos )const
    {
       try
       {
@@ -236,10 +453,27 @@ namespace futurepia { namespace chain {
       try
       {
       optional< signed_block > b;
-      uint64_t pos = get_block_pos( block_num );
+
+      if( has_writer() )
+      {
+         fc::scoped_lock< boost::mutex > lock( my->queue_mutex );
+         if( !my->queue.empty() )
+         {
+            uint32_t first_num = my->queue.front()->block_num();
+            if( block_num >= first_num && block_num - first_num < my->queue.size() )
+            {
+               b = *my->queue[ block_num - first_num ];
+               return b;
+            }
+         }
+      }
+
+      // A block leaves the queue only after it is written, so checking the file second cannot miss it
+      fc::scoped_lock< boost::mutex > lock( my->io_mutex );
+      uint64_t pos = get_block_pos_unlocked( block_num );
       if( pos != npos )
       {
-         b = read_block( pos ).first;
+         b = read_block_unlocked( pos ).first;
          FC_ASSERT( b->block_num() == block_num , "Wrong block was read from block log.", ( "returned", b->block_num() )( "expected", block_num ));
       }
       return b;
@@ -247,13 +481,93 @@ namespace futurepia { namespace chain {
       FC_LOG_AND_RETHROW()
    }
 
+   std::vector< std::vector< char > > block_log::read_raw_blocks( uint32_t start_block_num, uint32_t count, uint64_t max_bytes )const
+   {
+      try
+      {
+         std::vector< std::vector< char > > result;
+
+         {
+            fc::scoped_lock< boost::mutex > lock( my->io_mutex );
+            if( start_block_num > 0 && start_block_num <= my->file_head_num && count > 0 )
+            {
+               my->check_index_read();
+               my->check_block_read();
+
+               uint32_t last = std::min< uint64_t >( my->file_head_num, uint64_t( start_block_num ) + count - 1 );
+
+               // Block n ends 8 bytes, its own position, before block n + 1 starts. The last block of the file
+               // ends 8 bytes before the end of the file.
+               std::vector< uint64_t > pos( last - start_block_num + 2 );
+               my->index_stream.seekg( sizeof( uint64_t ) * ( start_block_num - 1 ) );
+               if( last < my->file_head_num )
+               {
+                  my->index_stream.read( (char*)pos.data(), pos.size() * sizeof( uint64_t ) );
+               }
+               else
+               {
+                  my->index_stream.read( (char*)pos.data(), ( pos.size() - 1 ) * sizeof( uint64_t ) );
+                  my->block_stream.seekg( 0, std::ios::end );
+                  pos.back() = uint64_t( my->block_stream.tellg() );
+               }
+
+               size_t n = 1;
+               while( n < pos.size() - 1 && pos[ n + 1 ] - pos[ 0 ] <= max_bytes )
+                  ++n;
+
+               std::vector< char > data( pos[ n ] - pos[ 0 ] );
+               my->block_stream.seekg( pos[ 0 ] );
+               my->block_stream.read( data.data(), data.size() );
+
+               result.reserve( n );
+               for( size_t i = 0; i < n; ++i )
+                  result.emplace_back( data.begin() + ( pos[ i ] - pos[ 0 ] ), data.begin() + ( pos[ i + 1 ] - pos[ 0 ] - sizeof( uint64_t ) ) );
+            }
+         }
+
+         if( result.size() < count && has_writer() )
+         {
+            fc::scoped_lock< boost::mutex > lock( my->queue_mutex );
+            uint64_t bytes = 0;
+            for( const auto& b : result )
+               bytes += b.size();
+
+            uint32_t next = start_block_num + result.size();
+            if( !my->queue.empty() && next >= my->queue.front()->block_num() )
+            {
+               for( size_t i = next - my->queue.front()->block_num(); i < my->queue.size() && result.size() < count; ++i )
+               {
+                  std::vector< char > packed = fc::raw::pack( *my->queue[ i ] );
+                  bytes += packed.size();
+                  if( bytes > max_bytes && !result.empty() )
+                     break;
+                  result.push_back( std::move( packed ) );
+               }
+            }
+         }
+
+         return result;
+      }
+      FC_LOG_AND_RETHROW()
+   }
+
    uint64_t block_log::get_block_pos( uint32_t block_num ) const
+   {
+      try
+      {
+         fc::scoped_lock< boost::mutex > lock( my->io_mutex );
+         return get_block_pos_unlocked( block_num );
+      }
+      FC_LOG_AND_RETHROW()
+   }
+
+   uint64_t block_log::get_block_pos_unlocked( uint32_t block_num ) const
    {
       try
       {
          my->check_index_read();
 
-         if( !( my->head.valid() && block_num <= protocol::block_header::num_from_id( my->head_id ) && block_num > 0 ) )
+         if( !( block_num <= my->file_head_num && block_num > 0 ) )
             return npos;
          my->index_stream.seekg( sizeof( uint64_t ) * ( block_num - 1 ) );
          uint64_t pos;
@@ -267,12 +581,13 @@ namespace futurepia { namespace chain {
    {
       try
       {
+         fc::scoped_lock< boost::mutex > lock( my->io_mutex );
          my->check_block_read();
 
          uint64_t pos;
          my->block_stream.seekg( -sizeof(pos), std::ios::end );
          my->block_stream.read( (char*)&pos, sizeof(pos) );
-         return read_block( pos ).first;
+         return read_block_unlocked( pos ).first;
       }
       FC_LOG_AND_RETHROW()
    }
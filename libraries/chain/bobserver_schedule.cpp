@@ -14,99 +14,54 @@ void update_bobserver_schedule4( database& db )
 //    active_bobservers.reserve( FUTUREPIA_MAX_BOBSERVERS );
    active_bobservers.reserve( FUTUREPIA_NUM_BOBSERVERS );
 
-   /// Add the highest voted bobservers
-   flat_set< bobserver_id_type > selected_bp;
-   selected_bp.reserve( bo_schedule_object.max_voted_bobservers );
-
    dlog( "BP : max_voted_bobservers = ${max BP}", ( "max BP", bo_schedule_object.max_voted_bobservers ) );
 
-   const auto& bp_idx = db.get_index< bobserver_index >().indices().get< by_is_bp >();  
-   for( auto itr = bp_idx.begin(); itr != bp_idx.end(); itr++ )
+   // The candidates are kept in order by the by_schedule and by_excepted indexes as bobservers are created and
+   // modified, so a round only visits the bobservers it changes or schedules
+   const auto& excepted_idx = db.get_index< bobserver_index >().indices().get< by_excepted >();
+   vector< bobserver_id_type > excepted;
+   for( auto itr = excepted_idx.lower_bound( boost::make_tuple( true, true ) );
+         itr != excepted_idx.end() && itr->is_excepted && itr->has_signing_key();
+         ++itr )
    {  // except a bo/bp in miner
-      if ( itr->is_excepted && itr->signing_key != public_key_type() ) 
-      {
-         db.modify( *itr, [&]( bobserver_object& o ) { 
-            o.signing_key = public_key_type();
-         } );
-         db.push_virtual_operation( shutdown_bobserver_operation( itr->account ) );
-      }
+      excepted.push_back( itr->id );
    }
 
-   for( auto itr = bp_idx.begin();
-         itr != bp_idx.end() && selected_bp.size() < bo_schedule_object.max_voted_bobservers;
-         ++itr )
+   for( const auto& id : excepted )
    {
-      if( itr->signing_key == public_key_type() || itr->is_bproducer == false )
-         continue;
-
-      selected_bp.insert( itr->id );
-      active_bobservers.push_back( itr->account) ;
+      const auto& bo = db.get( id );
+      db.modify( bo, [&]( bobserver_object& o ) {
+         o.signing_key = public_key_type();
+      } );
+      db.push_virtual_operation( shutdown_bobserver_operation( bo.account ) );
    }
 
-   dlog( "BP : BP active = ${active}", ( "active", active_bobservers ) );
-
-   auto num_bp = active_bobservers.size();
-
-   flat_set< bobserver_id_type > selected_miners;
-   selected_miners.reserve( bo_schedule_object.max_miner_bobservers );
-
-   const auto& bo_idx = db.get_index<bobserver_index>().indices().get<by_name>();
-   auto now_hi = uint64_t(db.head_block_time().sec_since_epoch()) << 32;
-   uint32_t sigma_num = bo_idx.size() - selected_bp.size();
-
-   vector< account_name_type > available_bobservers;
-   available_bobservers.reserve( sigma_num );
-
-   for( auto itr = bo_idx.begin(); itr != bo_idx.end(); ++itr )
-   {
-      if( itr->signing_key != public_key_type() && selected_bp.find( itr->id ) == selected_bp.end() )
-         available_bobservers.emplace_back( itr->account );
-   }
+   /// Add the highest voted bobservers
+   const auto& schedule_idx = db.get_index< bobserver_index >().indices().get< by_schedule >();
+   auto bp_itr = schedule_idx.lower_bound( boost::make_tuple( true, true ) );
+   auto bp_end = schedule_idx.lower_bound( boost::make_tuple( true, false ) );
+   auto miner_end = schedule_idx.lower_bound( boost::make_tuple( false ) );
 
-   sigma_num = available_bobservers.size();
-   uint32_t max_num = std::min( (uint32_t)( FUTUREPIA_NUM_BOBSERVERS - active_bobservers.size() ), sigma_num );
+   for( ; bp_itr != bp_end && active_bobservers.size() < bo_schedule_object.max_voted_bobservers; ++bp_itr )
+      active_bobservers.push_back( bp_itr->account );
 
-   dlog( "BP : max_num = ${max}, now_hi = ${hi}, sigma_num = ${num}"
-      , ( "max", max_num )( "hi", now_hi )( "num", sigma_num ) );
+   dlog( "BP : BP active = ${active}", ( "active", active_bobservers ) );
 
-   dlog( "BP : BP available_bobservers = ${active}", ( "active", available_bobservers ) );
+   auto num_bp = active_bobservers.size();
 
-   if ( sigma_num > 0 )
+   // Fill the remaining slots with the other bobservers that have a signing key in account name order, which
+   // merges the block producers that were not selected with the rest
+   auto miner_itr = bp_end;
+   size_t num_miners = 0;
+   while( active_bobservers.size() < FUTUREPIA_NUM_BOBSERVERS && ( bp_itr != bp_end || miner_itr != miner_end ) )
    {
-      uint32_t temp_index[sigma_num];
-      for( uint32_t i = 0; i < sigma_num ; ++i )
-      {
-         temp_index[i] = i;
-      }
-
-      uint32_t index = 0;
-      while ( index < max_num )
-      {
-         int i = 0;
-         int j = temp_index[index];
-         for( auto owner_itr = available_bobservers.begin(); owner_itr!= available_bobservers.end(); ++owner_itr )
-         {
-            auto itr = bo_idx.find( *owner_itr );
-            string bo = itr->account;
-
-            if ( i == j )
-            {
-               if( selected_miners.find(itr->id) != selected_miners.end() )
-                  break;
-
-               active_bobservers.push_back( itr->account) ;
-               dlog("selected blockobserver : ${b}", ("b", bo));
-               selected_miners.insert(itr->id);
-               break;
-            }
-
-            i++;
-         }
-         index++;
-      }
+      auto& next = miner_itr == miner_end || ( bp_itr != bp_end && bp_itr->account < miner_itr->account ) ? bp_itr : miner_itr;
+      active_bobservers.push_back( next->account );
+      dlog("selected blockobserver : ${b}", ("b", next->account));
+      ++next;
+      ++num_miners;
    }
 
-   auto num_miners = selected_miners.size();
    auto num_timeshare = active_bobservers.size() - num_miners - num_bp;
    dlog( "BP : num_timeshare = ${num_time}, num_miners = ${num_miners}, num_bp = ${num_bp}"
       , ( "num_time", num_timeshare )( "num_miners", num_miners )( "num_bp", num_bp ) );
@@ -125,8 +125,43 @@ void database::open( const fc::path& data_dir, const fc::path& shared_mem_dir, u
             // This assertion should be caught and a reindex should occur
             FC_ASSERT( head_block.valid() && head_block->id() == head_block_id(), "Chain state does not match block log. Please reindex blockchain." );
 
+            // The state may be behind the log if we stopped before the undo history of persisted blocks was
+            // committed. Those blocks are irreversible, apply them from the log instead of fetching them again.
+            if( log_head && log_head->block_num() > head_block_num() )
+            {
+               ilog( "Replaying blocks ${b} to ${e} from block log", ("b", head_block_num() + 1)("e", log_head->block_num()) );
+
+               uint64_t skip_flags =
+                  skip_bobserver_signature |
+                  skip_transaction_signatures |
+                  skip_transaction_dupe_check |
+                  skip_tapos_check |
+                  skip_merkle_check |
+                  skip_bobserver_schedule_check |
+                  skip_authority_check |
+                  skip_validate |
+                  skip_validate_invariants |
+                  skip_block_log;
+
+               with_write_lock( [&]()
+               {
+                  for( uint32_t block_num = head_block_num() + 1; block_num <= log_head->block_num(); ++block_num )
+                  {
+                     auto block = _block_log.read_block_by_num( block_num );
+                     FC_ASSERT( block.valid(), "Block log is missing block ${n}", ("n", block_num) );
+                     apply_block( *block, block->id(), skip_flags );
+                  }
+                  set_revision( head_block_num() );
+               });
+
+               head_block = log_head;
+            }
+
             _fork_db.start_block( *head_block );
          }
+
+         if( _block_log_queue_size )
+            _block_log.start_writer( _block_log_queue_size );
       }
 
       with_read_lock( [&]()
@@ -175,11 +210,13 @@ void database::reindex( const fc::path& data_dir, const fc::path& shared_mem_dir
             if( cur_block_num % 100000 == 0 )
                std::cerr << "   " << double( cur_block_num * 100 ) / last_block_num << "%   " << cur_block_num << " of " << last_block_num <<
                "   (" << (get_free_memory() / (1024*1024)) << "M free)\n";
-            apply_block( itr.first, skip_flags );
+            check_shared_file_growth();
+            apply_block( itr.first, itr.first.id(), skip_flags );
             itr = _block_log.read_block( itr.second );
          }
 
-         apply_block( itr.first, skip_flags );
+         check_shared_file_growth();
+         apply_block( itr.first, itr.first.id(), skip_flags );
          set_revision( head_block_num() );
       });
 
@@ -309,6 +346,42 @@ optional<signed_block> database::fetch_block_by_number( uint32_t block_num )cons
    return b;
 } FC_LOG_AND_RETHROW() }
 
+vector< vector< char > > database::fetch_raw_blocks( uint32_t start, uint32_t count, uint64_t max_bytes )const
+{ try {
+   vector< vector< char > > result;
+
+   if( start == 0 || count == 0 )
+      return result;
+
+   // The block log only holds irreversible blocks, anything past its head comes from the fork database
+   uint32_t log_head = _block_log.head() ? _block_log.head()->block_num() : 0;
+   if( start <= log_head )
+   {
+      result = _block_log.read_raw_blocks( start, std::min< uint64_t >( count, log_head - start + 1 ), max_bytes );
+      if( start + result.size() <= log_head )
+         return result;
+   }
+
+   uint64_t bytes = 0;
+   for( const auto& b : result )
+      bytes += b.size();
+
+   while( result.size() < count )
+   {
+      optional< signed_block > b = fetch_block_by_number( start + result.size() );
+      if( !b.valid() )
+         break;
+
+      vector< char > packed = fc::raw::pack( *b );
+      bytes += packed.size();
+      if( bytes > max_bytes && !result.empty() )
+         break;
+      result.push_back( std::move( packed ) );
+   }
+
+   return result;
+} FC_CAPTURE_AND_RETHROW( (start)(count)(max_bytes) ) }
+
 const signed_transaction database::get_recent_transaction( const transaction_id_type& trx_id ) const
 { try {
    auto& index = get_index<transaction_index>().indices().get<by_trx_id>();
@@ -459,6 +532,9 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
 {
    //fc::time_point begin_time = fc::time_point::now();
 
+   uint64_t block_ids = protocol::id_hash_counters::block_ids;
+   uint64_t transaction_ids = protocol::id_hash_counters::transaction_ids;
+
    bool result;
    detail::with_skip_flags( *this, skip, [&]()
    {
@@ -472,6 +548,10 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
             }
             FC_CAPTURE_AND_RETHROW( (new_block) )
          });
+
+         // Read by database_api under the read lock
+         _last_block_id_hashes.block_ids = protocol::id_hash_counters::block_ids - block_ids;
+         _last_block_id_hashes.transaction_ids = protocol::id_hash_counters::transaction_ids - transaction_ids;
       });
    });
 
@@ -501,11 +581,17 @@ void database::_maybe_warn_multiple_production( uint32_t height )const
 bool database::_push_block(const signed_block& new_block)
 { try {
    uint32_t skip = get_node_properties().skip_flags;
+
+   // No undo session is open yet, the pending one was cleared by push_block()
+   check_shared_file_growth();
    //uint32_t skip_undo_db = skip & skip_undo_block;
 
+   // Hashed once here and handed down to the fork database, apply_block and the block summary
+   const block_id_type new_block_id = new_block.id();
+
    if( !(skip&skip_fork_db) )
    {
-      shared_ptr<fork_item> new_head = _fork_db.push_block(new_block);
+      shared_ptr<fork_item> new_head = _fork_db.push_block(new_block, new_block_id);
       _maybe_warn_multiple_production( new_head->num );
 
       //If the head block from the longest chain does not build off of the current head, we need to switch forks.
@@ -516,7 +602,7 @@ bool database::_push_block(const signed_block& new_block)
          if( new_head->data.block_num() > head_block_num() )
          {
             // wlog( "Switching to fork: ${id}", ("id",new_head->data.id()) );
-            auto branches = _fork_db.fetch_branch_from(new_head->data.id(), head_block_id());
+            auto branches = _fork_db.fetch_branch_from(new_head->id, head_block_id());
 
             // pop blocks until we hit the forked block
             while( head_block_id() != branches.second.back()->data.previous )
@@ -530,7 +616,7 @@ bool database::_push_block(const signed_block& new_block)
                 try
                 {
                    auto session = start_undo_session( true );
-                   apply_block( (*ritr)->data, skip );
+                   apply_block( (*ritr)->data, (*ritr)->id, skip );
                    session.push();
                 }
                 catch ( const fc::exception& e ) { except = e; }
@@ -540,7 +626,7 @@ bool database::_push_block(const signed_block& new_block)
                    // remove the rest of branches.first from the fork_db, those blocks are invalid
                    while( ritr != branches.first.rend() )
                    {
-                      _fork_db.remove( (*ritr)->data.id() );
+                      _fork_db.remove( (*ritr)->id );
                       ++ritr;
                    }
                    _fork_db.set_head( branches.second.front() );
@@ -553,7 +639,7 @@ bool database::_push_block(const signed_block& new_block)
                    for( auto ritr = branches.second.rbegin(); ritr != branches.second.rend(); ++ritr )
                    {
                       auto session = start_undo_session( true );
-                      apply_block( (*ritr)->data, skip );
+                      apply_block( (*ritr)->data, (*ritr)->id, skip );
                       session.push();
                    }
                    throw *except;
@@ -569,13 +655,13 @@ bool database::_push_block(const signed_block& new_block)
    try
    {
       auto session = start_undo_session( true );
-      apply_block(new_block, skip);
+      apply_block(new_block, new_block_id, skip);
       session.push();
    }
    catch( const fc::exception& e )
    {
       elog("Failed to push new block:\n${e}", ("e", e.to_detail_string()));
-      _fork_db.remove(new_block.id());
+      _fork_db.remove(new_block_id);
       throw;
    }
 
@@ -853,6 +939,28 @@ void database::push_virtual_operation( const operation& op, bool force )
    notify_post_apply_operation( note );
 }
 
+const operation_object& database::get_or_create_operation_object( const operation_notification& note )
+{
+   if( note.history_object == nullptr )
+   {
+      note.history_object = &create< operation_object >( [&]( operation_object& obj )
+      {
+         obj.trx_id       = note.trx_id;
+         obj.block        = note.block;
+         obj.trx_in_block = note.trx_in_block;
+         obj.op_in_trx    = note.op_in_trx;
+         obj.virtual_op   = note.virtual_op;
+         obj.timestamp    = head_block_time();
+         auto size = fc::raw::pack_size( note.op );
+         obj.serialized_op.resize( size );
+         fc::datastream< char* > ds( obj.serialized_op.data(), size );
+         fc::raw::pack( ds, note.op );
+      });
+   }
+
+   return *note.history_object;
+}
+
 void database::notify_applied_block( const signed_block& block )
 {
    FUTUREPIA_TRY_NOTIFY( applied_block, block )
@@ -1064,44 +1172,24 @@ void database::process_savings_withdraws()
          itr = idx.begin();
 
       } else {
-         
-         account_name_type from              = itr->from;
-         account_name_type to                = itr->to;
-         shared_string     memo              = itr->memo;
-         uint32_t          request_id        = itr->request_id;
-         asset             amount            = itr->amount;
-         asset             total_amount      = itr->total_amount;
-         uint8_t           split_pay_order   = itr->split_pay_order;
-         uint8_t           split_pay_month   = itr->split_pay_month;
-         time_point_sec    complete          = itr->complete;
-
          asset             monthly_amount    = itr->total_amount;
-         asset             savings_balance   = get_savings_balance(get_account( to ), monthly_amount.symbol);
+         asset             savings_balance   = get_savings_balance(get_account( itr->to ), monthly_amount.symbol);
 
-         monthly_amount.amount /= split_pay_month;
+         monthly_amount.amount /= itr->split_pay_month;
          FC_ASSERT(savings_balance >= monthly_amount);
 
-         adjust_balance( get_account( to ), monthly_amount );
-         adjust_savings_balance(get_account( to ), -monthly_amount);
+         adjust_balance( get_account( itr->to ), monthly_amount );
+         adjust_savings_balance(get_account( itr->to ), -monthly_amount);
 
-         push_virtual_operation( fill_transfer_savings_operation( from, to, monthly_amount, total_amount, split_pay_order, split_pay_month, request_id, to_string(memo) ) );
-         
-         remove( *itr );
-         itr = idx.begin();
+         push_virtual_operation( fill_transfer_savings_operation( itr->from, itr->to, monthly_amount, itr->total_amount, itr->split_pay_order, itr->split_pay_month, itr->request_id, to_string(itr->memo) ) );
 
-         create<savings_withdraw_object>( [&]( savings_withdraw_object& s ) {
-            s.from            = from;
-            s.to              = to;           
-            s.amount          = amount - monthly_amount;
-            s.total_amount    = total_amount;
-            s.split_pay_month = split_pay_month;
-            s.split_pay_order = split_pay_order + 1;
-#ifndef IS_LOW_MEM
-            s.memo            = memo;
-#endif
-            s.request_id      = request_id;
-            s.complete        = complete + FUTUREPIA_TRANSFER_SAVINGS_CYCLE;
+         // Reschedule the next payment in place, the object only moves forward in by_complete_from_rid
+         modify( *itr, [&]( savings_withdraw_object& s ) {
+            s.amount          -= monthly_amount;
+            s.split_pay_order += 1;
+            s.complete        += FUTUREPIA_TRANSFER_SAVINGS_CYCLE;
          });
+         itr = idx.begin();
       }
    }
 }
@@ -1346,6 +1434,8 @@ void database::set_custom_operation_interpreter( const std::string& id, std::sha
    bool inserted = _custom_operation_interpreters.emplace( id, registry ).second;
    // This assert triggering means we're mis-configured (multiple registrations of custom JSON evaluator for same ID)
    FC_ASSERT( inserted );
+   if( _custom_operation_cache_size.valid() )
+      registry->set_cache_size( *_custom_operation_cache_size );
 }
 
 std::shared_ptr< custom_operation_interpreter > database::get_custom_evaluator( const std::string& id )
@@ -1356,6 +1446,14 @@ std::shared_ptr< custom_operation_interpreter > database::get_custom_evaluator(
    return std::shared_ptr< custom_operation_interpreter >();
 }
 
+flat_map< std::string, custom_operation_cache_stats > database::get_custom_operation_cache_stats()const
+{
+   flat_map< std::string, custom_operation_cache_stats > result;
+   for( const auto& p : _custom_operation_interpreters )
+      result[ p.first ] = p.second->get_cache_stats();
+   return result;
+}
+
 void database::initialize_indexes()
 {
    add_core_index< dynamic_global_property_index           >(*this);
@@ -1382,6 +1480,7 @@ void database::initialize_indexes()
    add_core_index< fund_withdraw_index                     >(*this);
    add_core_index< exchange_withdraw_index                 >(*this);
    add_core_index< dapp_reward_fund_index                  >(*this);
+   add_core_index< block_operations_index                  >(*this);
 
    _plugin_index_signal();
 }
@@ -1592,9 +1691,33 @@ void database::set_flush_interval( uint32_t flush_blocks )
    _next_flush_block = 0;
 }
 
+void database::set_block_log_queue_size( uint32_t blocks )
+{
+   _block_log_queue_size = blocks;
+}
+
+void database::set_block_operations_depth( uint32_t blocks )
+{
+   _block_operations_depth = blocks;
+}
+
+void database::set_transaction_check_threads( uint32_t threads )
+{
+   _trx_preprocessor.reset();
+   if( threads > 0 )
+      _trx_preprocessor.reset( new transaction_preprocessor( threads ) );
+}
+
+void database::set_custom_operation_cache_size( uint32_t entries )
+{
+   _custom_operation_cache_size = entries;
+   for( const auto& p : _custom_operation_interpreters )
+      p.second->set_cache_size( entries );
+}
+
 //////////////////// private methods ////////////////////
 
-void database::apply_block( const signed_block& next_block, uint32_t skip )
+void database::apply_block( const signed_block& next_block, const block_id_type& next_block_id, uint32_t skip )
 { try {
    //fc::time_point begin_time = fc::time_point::now();
 
@@ -1603,7 +1726,7 @@ void database::apply_block( const signed_block& next_block, uint32_t skip )
    {
       auto itr = _checkpoints.find( block_num );
       if( itr != _checkpoints.end() )
-         FC_ASSERT( next_block.id() == itr->second, "Block did not match checkpoint", ("checkpoint",*itr)("block_id",next_block.id()) );
+         FC_ASSERT( next_block_id == itr->second, "Block did not match checkpoint", ("checkpoint",*itr)("block_id",next_block_id) );
 
       if( _checkpoints.rbegin()->first >= block_num )
          skip = skip_bobserver_signature
@@ -1623,7 +1746,7 @@ void database::apply_block( const signed_block& next_block, uint32_t skip )
 
    detail::with_skip_flags( *this, skip, [&]()
    {
-      _apply_block( next_block );
+      _apply_block( next_block, next_block_id );
    } );
 
    /*try
@@ -1685,12 +1808,54 @@ void database::show_free_memory( bool force )
    }
 }
 
-void database::_apply_block( const signed_block& next_block )
+void database::set_shared_file_growth( uint16_t full_threshold, uint16_t scale_rate )
+{
+   _shared_file_full_threshold = full_threshold;
+   _shared_file_scale_rate = scale_rate;
+}
+
+void database::check_shared_file_growth()
+{
+   if( _shared_file_full_threshold == 0 || _shared_file_scale_rate == 0 )
+      return;
+
+   uint64_t file_size = get_shared_file_size();
+   uint64_t used = file_size - get_free_memory();
+
+   if( used * FUTUREPIA_100_PERCENT < file_size * _shared_file_full_threshold )
+      return;
+
+   if( head_block_num() < _next_shared_file_grow_block )
+      return;
+
+   uint64_t extra = file_size / FUTUREPIA_100_PERCENT * _shared_file_scale_rate;
+
+   // Either way the block is applied on the current mapping
+   switch( grow( extra, 100000 ) )
+   {
+      case grow_done:
+         break;
+      case grow_readers_active:
+         // Readers still on an older lock block the remap, it is tried again at the next block
+         wlog( "Shared memory file is ${p}% full, but API readers still hold locks, not growing it yet", ("p", used * 100 / file_size) );
+         return;
+      case grow_failed:
+         _next_shared_file_grow_block = head_block_num() + FUTUREPIA_BLOCKS_PER_HOUR;
+         elog( "Shared memory file is ${p}% full and could not be grown by ${e}M, retrying at block ${b}",
+            ("p", used * 100 / file_size)("e", extra / (1024*1024))("b", _next_shared_file_grow_block) );
+         return;
+   }
+
+   ilog( "Shared memory file was ${p}% full, grew it from ${s}M by ${e}M",
+      ("p", used * 100 / file_size)("s", file_size / (1024*1024))("e", extra / (1024*1024)) );
+   show_free_memory( true );
+}
+
+void database::_apply_block( const signed_block& next_block, const block_id_type& next_block_id )
 { try {
    notify_pre_apply_block( next_block );
 
    uint32_t next_block_num = next_block.block_num();
-   //block_id_type next_block_id = next_block.id();
 
    uint32_t skip = get_node_properties().skip_flags;
 
@@ -1700,7 +1865,7 @@ void database::_apply_block( const signed_block& next_block )
 
       try
       {
-         FC_ASSERT( next_block.transaction_merkle_root == merkle_root, "Merkle check failed", ("next_block.transaction_merkle_root",next_block.transaction_merkle_root)("calc",merkle_root)("next_block",next_block)("id",next_block.id()) );
+         FC_ASSERT( next_block.transaction_merkle_root == merkle_root, "Merkle check failed", ("next_block.transaction_merkle_root",next_block.transaction_merkle_root)("calc",merkle_root)("next_block",next_block)("id",next_block_id) );
       }
       catch( fc::assert_exception& e )
       {
@@ -1714,6 +1879,9 @@ void database::_apply_block( const signed_block& next_block )
 
    const bobserver_object& signing_bobserver = validate_block_header(skip, next_block);
 
+   // The previous block is complete only once every applied_block handler has pushed its virtual operations
+   create_block_operations( head_block_num() );
+
    _current_block_num    = next_block_num;
    _current_trx_in_block = 0;
    _current_virtual_op   = 0;
@@ -1739,6 +1907,11 @@ void database::_apply_block( const signed_block& next_block )
    /// parse bobserver version reporting
    process_header_extensions( next_block );
 
+   bool precomputed = _trx_preprocessor && next_block.transactions.size() > 1;
+   if( precomputed )
+      _trx_preprocessor->process( next_block.transactions, FUTUREPIA_CHAIN_ID,
+         !( skip & skip_validate ), !( skip & ( skip_transaction_signatures | skip_authority_check ) ) );
+
    for( const auto& trx : next_block.transactions )
    {
       /* We do not need to push the undo state for each transaction
@@ -1747,18 +1920,20 @@ void database::_apply_block( const signed_block& next_block )
        * for transactions when validating broadcast transactions or
        * when building a block.
        */
+      if( precomputed )
+         _precomputed_trx = &_trx_preprocessor->get( _current_trx_in_block );
       apply_transaction( trx, skip );
       ++_current_trx_in_block;
    }
 
    _current_virtual_op   = 0;
 
-   update_global_dynamic_data(next_block);
+   update_global_dynamic_data(next_block, next_block_id);
    update_signing_bobserver(signing_bobserver, next_block);
 
    update_last_irreversible_block();
 
-   create_block_summary(next_block);
+   create_block_summary(next_block, next_block_id);
    clear_expired_transactions();
 
    update_bobserver_schedule(*this);
@@ -1842,16 +2017,27 @@ void database::apply_transaction(const signed_transaction& trx, uint32_t skip)
 
 void database::_apply_transaction(const signed_transaction& trx)
 { try {
-   _current_trx_id = trx.id();
+   const transaction_preprocessor::result* precomputed = _precomputed_trx;
+   _precomputed_trx = nullptr;
+
+   _current_trx_id = precomputed ? precomputed->id : trx.id();
    _current_virtual_op   = 0;
    uint32_t skip = get_node_properties().skip_flags;
 
    if( !(skip&skip_validate) )   /* issue #505 explains why this skip_flag is disabled */
-      trx.validate();
+   {
+      if( precomputed && precomputed->validated )
+      {
+         if( precomputed->validate_error )
+            std::rethrow_exception( precomputed->validate_error );
+      }
+      else
+         trx.validate();
+   }
 
    auto& trx_idx = get_index<transaction_index>();
    const chain_id_type& chain_id = FUTUREPIA_CHAIN_ID;
-   auto trx_id = trx.id();
+   auto trx_id = _current_trx_id;
    // idump((trx_id)(skip&skip_transaction_dupe_check));
    FC_ASSERT( (skip & skip_transaction_dupe_check) ||
               trx_idx.indices().get<by_trx_id>().find(trx_id) == trx_idx.indices().get<by_trx_id>().end(),
@@ -1865,7 +2051,14 @@ void database::_apply_transaction(const signed_transaction& trx)
 
       try
       {
-         trx.verify_authority( chain_id, get_active, get_owner, get_posting, FUTUREPIA_MAX_SIG_CHECK_DEPTH );
+         if( precomputed && precomputed->keys_recovered )
+         {
+            if( precomputed->signature_error )
+               std::rethrow_exception( precomputed->signature_error );
+            protocol::verify_authority( trx.operations, precomputed->signature_keys, get_active, get_owner, get_posting, FUTUREPIA_MAX_SIG_CHECK_DEPTH );
+         }
+         else
+            trx.verify_authority( chain_id, get_active, get_owner, get_posting, FUTUREPIA_MAX_SIG_CHECK_DEPTH );
       }
       catch( protocol::tx_missing_active_auth& e )
       {
@@ -1951,15 +2144,61 @@ const bobserver_object& database::validate_block_header( uint32_t skip, const si
    return bobserver;
 } FC_CAPTURE_AND_RETHROW() }
 
-void database::create_block_summary(const signed_block& next_block)
+void database::create_block_summary( const signed_block& next_block, const block_id_type& next_block_id )
 { try {
    block_summary_id_type sid( next_block.block_num() & 0xffff );
    modify( get< block_summary_object >( sid ), [&](block_summary_object& p) {
-         p.block_id = next_block.id();
+         p.block_id = next_block_id;
    });
 } FC_CAPTURE_AND_RETHROW() }
 
-void database::update_global_dynamic_data( const signed_block& b )
+void database::create_block_operations( uint32_t block_num )
+{ try {
+   // Tables of irreversible blocks past the configured depth are dropped, get_ops_in_block falls back to operation_index
+   const auto& table_idx = get_index< block_operations_index >().indices().get< by_block >();
+   uint32_t last_irreversible = get_dynamic_global_properties().last_irreversible_block_num;
+   while( !table_idx.empty() && table_idx.begin()->block <= last_irreversible
+          && uint64_t( table_idx.begin()->block ) + _block_operations_depth <= block_num )
+      remove( *table_idx.begin() );
+
+   if( _block_operations_depth == 0 || block_num == 0 || find< block_operations_object, by_block >( block_num ) != nullptr )
+      return;
+
+   const auto& idx = get_index< operation_index >().indices().get< by_location >();
+   auto itr = idx.lower_bound( block_num );
+   if( itr == idx.end() || itr->block != block_num )
+      return;
+
+   create< block_operations_object >( [&]( block_operations_object& b )
+   {
+      b.block = block_num;
+
+      for( ; itr != idx.end() && itr->block == block_num; ++itr )
+      {
+         uint32_t index = b.offsets.size();
+         if( index % 64 == 0 )
+            b.virtual_ops.push_back( 0 );
+         if( itr->virtual_op )
+            b.virtual_ops.back() |= uint64_t( 1 ) << ( index % 64 );
+
+         block_operation_header header;
+         header.trx_id       = itr->trx_id;
+         header.trx_in_block = itr->trx_in_block;
+         header.op_in_trx    = itr->op_in_trx;
+         header.virtual_op   = itr->virtual_op;
+         header.timestamp    = itr->timestamp;
+         auto packed_header = fc::raw::pack( header );
+
+         b.offsets.push_back( b.packed_ops.size() );
+         b.packed_ops.insert( b.packed_ops.end(), packed_header.begin(), packed_header.end() );
+         b.packed_ops.insert( b.packed_ops.end(), itr->serialized_op.begin(), itr->serialized_op.end() );
+      }
+
+      b.offsets.push_back( b.packed_ops.size() );
+   });
+} FC_CAPTURE_AND_RETHROW( (block_num) ) }
+
+void database::update_global_dynamic_data( const signed_block& b, const block_id_type& b_id )
 { try {
    const dynamic_global_property_object& _dgp =
       get_dynamic_global_properties();
@@ -1995,7 +2234,7 @@ void database::update_global_dynamic_data( const signed_block& b )
       }
 
       dgp.head_block_number = b.block_num();
-      dgp.head_block_id = b.id();
+      dgp.head_block_id = b_id;
       dgp.time = b.timestamp;
       dgp.current_aslot += missed_blocks+1;
    } );
@@ -2113,8 +2352,6 @@ void database::update_last_irreversible_block()
       }
    }
 
-   commit( dpo.last_irreversible_block_num );
-
    if( !( get_node_properties().skip_flags & skip_block_log ) )
    {
       // output to block log based on new last irreverisible block num
@@ -2130,12 +2367,22 @@ void database::update_last_irreversible_block()
          {
             shared_ptr< fork_item > block = _fork_db.fetch_block_on_main_branch_by_number( log_head_num+1 );
             FC_ASSERT( block, "Current fork in the fork database does not contain the last_irreversible_block" );
-            _block_log.append( block->data );
+            _block_log.append( block->block, block->id );
             log_head_num++;
          }
 
-         _block_log.flush();
+         // With the background writer the blocks are flushed in batches off the write lock
+         if( !_block_log.has_writer() )
+            _block_log.flush();
       }
+
+      // Keep the undo history of blocks that are not on disk yet, so a crash rewinds the state to a block
+      // the log still has and the rest is replayed from it on open
+      commit( std::min( dpo.last_irreversible_block_num, _block_log.persisted_block_num() ) );
+   }
+   else
+   {
+      commit( dpo.last_irreversible_block_num );
    }
 
    _fork_db.set_max_size( dpo.head_block_number - dpo.last_irreversible_block_num + 1 );
@@ -10,7 +10,10 @@ fork_database::fork_database()
 void fork_database::reset()
 {
    _head.reset();
-   _index.clear();
+   for( auto& slot : _slots )
+      slot.clear();
+   _first_num = 0;
+   _last_num = 0;
 }
 
 void fork_database::pop_block()
@@ -23,27 +26,32 @@ void fork_database::pop_block()
 
 void     fork_database::start_block(signed_block b)
 {
+   reset();
    auto item = std::make_shared<fork_item>(std::move(b));
-   _index.insert(item);
+   _insert(item);
    _head = item;
 }
 
 /**
- * Pushes the block into the fork database and caches it if it doesn't link
+ * Pushes the block into the fork database
  *
  */
 shared_ptr<fork_item>  fork_database::push_block(const signed_block& b)
 {
-   auto item = std::make_shared<fork_item>(b);
+   return push_block( b, b.id() );
+}
+
+shared_ptr<fork_item>  fork_database::push_block(const signed_block& b, const block_id_type& id)
+{
+   auto item = std::make_shared<fork_item>(std::make_shared< const signed_block >(b), id);
    try {
       _push_block(item);
    }
    catch ( const unlinkable_block_exception& e )
    {
-      wlog( "Pushing block to fork database that failed to link: ${id}, ${num}", ("id",b.id())("num",b.block_num()) );
-      wlog( "Head: ${num}, ${id}", ("num",_head->data.block_num())("id",_head->data.id()) );
+      wlog( "Pushing block to fork database that failed to link: ${id}, ${num}", ("id",item->id)("num",item->num) );
+      wlog( "Head: ${num}, ${id}", ("num",_head->num)("id",_head->id) );
       throw;
-      _unlinked_index.insert( item );
    }
    return _head;
 }
@@ -57,38 +65,58 @@ void  fork_database::_push_block(const item_ptr& item)
                  ("item->num",item->num)("head",_head->num)("max_size",_max_size));
    }
 
+   // A block pushed again is already linked in its slot
+   if( fetch_block( item->id ) )
+      return;
+
    if( _head && item->previous_id() != block_id_type() )
    {
-      auto& index = _index.get<block_id>();
-      auto itr = index.find(item->previous_id());
-      FUTUREPIA_ASSERT(itr != index.end(), unlinkable_block_exception, "block does not link to known chain");
-      FC_ASSERT(!(*itr)->invalid);
-      item->prev = *itr;
+      auto prev = fetch_block(item->previous_id());
+      FUTUREPIA_ASSERT(prev, unlinkable_block_exception, "block does not link to known chain");
+      FC_ASSERT(!prev->invalid);
+      item->prev = prev;
    }
 
-   _index.insert(item);
+   _insert(item);
    if( !_head || item->num > _head->num ) _head = item;
 }
 
-/**
- *  Iterate through the unlinked cache and insert anything that
- *  links to the newly inserted item.  This will start a recursive
- *  set of calls performing a depth-first insertion of pending blocks as
- *  _push_next(..) calls _push_block(...) which will in turn call _push_next
- */
-void fork_database::_push_next( const item_ptr& new_item )
+void fork_database::_insert(const item_ptr& item)
 {
-    auto& prev_idx = _unlinked_index.get<by_previous>();
+   if( _first_num == 0 )
+   {
+      _first_num = item->num;
+      _last_num = item->num;
+   }
+   else if( _slot(item->num) == nullptr )
+   {
+      // Blocks link to a block in the ring, so they are at most one past the highest one
+      FC_ASSERT( item->num == _last_num + 1, "block ${n} is outside of the fork database", ("n",item->num)("first",_first_num)("last",_last_num) );
+      _last_num = item->num;
+   }
+
+   uint64_t needed = uint64_t(_last_num) - _first_num + 1;
+   if( needed > _slots.size() )
+   {
+      size_t capacity = std::max< size_t >( _slots.size(), 64 );
+      while( capacity < needed )
+         capacity *= 2;
+
+      vector< vector<item_ptr> > slots( capacity );
+      for( auto& slot : _slots )
+         for( auto& i : slot )
+            slots[ i->num & ( capacity - 1 ) ].push_back( std::move(i) );
+      _slots.swap( slots );
+   }
 
-    auto itr = prev_idx.find( new_item->id );
-    while( itr != prev_idx.end() )
-    {
-       auto tmp = *itr;
-       prev_idx.erase( itr );
-       _push_block( tmp );
+   _slots[ item->num & ( _slots.size() - 1 ) ].push_back( item );
+}
 
-       itr = prev_idx.find( new_item->id );
-    }
+const vector<item_ptr>* fork_database::_slot(uint32_t num)const
+{
+   if( _first_num == 0 || num < _first_num || num > _last_num )
+      return nullptr;
+   return &_slots[ num & ( _slots.size() - 1 ) ];
 }
 
 void fork_database::set_max_size( uint32_t s )
@@ -96,53 +124,32 @@ void fork_database::set_max_size( uint32_t s )
    _max_size = s;
    if( !_head ) return;
 
-   { /// index
-      auto& by_num_idx = _index.get<block_num>();
-      auto itr = by_num_idx.begin();
-      while( itr != by_num_idx.end() )
-      {
-         if( (*itr)->num < std::max(int64_t(0),int64_t(_head->num) - _max_size) )
-            by_num_idx.erase(itr);
-         else
-            break;
-         itr = by_num_idx.begin();
-      }
-   }
-   { /// unlinked_index
-      auto& by_num_idx = _unlinked_index.get<block_num>();
-      auto itr = by_num_idx.begin();
-      while( itr != by_num_idx.end() )
-      {
-         if( (*itr)->num < std::max(int64_t(0),int64_t(_head->num) - _max_size) )
-            by_num_idx.erase(itr);
-         else
-            break;
-         itr = by_num_idx.begin();
-      }
+   // Only the slots that fall out of the window are visited
+   int64_t first_kept = std::max(int64_t(0),int64_t(_head->num) - _max_size);
+   while( _first_num != 0 && _first_num < first_kept )
+   {
+      _slots[ _first_num & ( _slots.size() - 1 ) ].clear();
+      if( _first_num == _last_num )
+         _first_num = _last_num = 0;
+      else
+         ++_first_num;
    }
 }
 
 bool fork_database::is_known_block(const block_id_type& id)const
 {
-   auto& index = _index.get<block_id>();
-   auto itr = index.find(id);
-   if( itr != index.end() )
-      return true;
-   auto& unlinked_index = _unlinked_index.get<block_id>();
-   auto unlinked_itr = unlinked_index.find(id);
-   return unlinked_itr != unlinked_index.end();
+   return fetch_block(id) != item_ptr();
 }
 
 item_ptr fork_database::fetch_block(const block_id_type& id)const
 {
-   auto& index = _index.get<block_id>();
-   auto itr = index.find(id);
-   if( itr != index.end() )
-      return *itr;
-   auto& unlinked_index = _unlinked_index.get<block_id>();
-   auto unlinked_itr = unlinked_index.find(id);
-   if( unlinked_itr != unlinked_index.end() )
-      return *unlinked_itr;
+   auto slot = _slot( protocol::block_header::num_from_id(id) );
+   if( slot != nullptr )
+   {
+      for( const auto& item : *slot )
+         if( item->id == id )
+            return item;
+   }
    return item_ptr();
 }
 
@@ -150,17 +157,10 @@ vector<item_ptr> fork_database::fetch_block_by_number(uint32_t num)const
 {
    try
    {
-   vector<item_ptr> result;
-   auto itr = _index.get<block_num>().find(num);
-   while( itr != _index.get<block_num>().end() )
-   {
-      if( (*itr)->num == num )
-         result.push_back( *itr );
-      else
-         break;
-      ++itr;
-   }
-   return result;
+   auto slot = _slot(num);
+   if( slot == nullptr )
+      return vector<item_ptr>();
+   return *slot;
    }
    FC_LOG_AND_RETHROW()
 }
@@ -171,13 +171,11 @@ pair<fork_database::branch_type,fork_database::branch_type>
    // This function gets a branch (i.e. vector<fork_item>) leading
    // back to the most recent common ancestor.
    pair<branch_type,branch_type> result;
-   auto first_branch_itr = _index.get<block_id>().find(first);
-   FC_ASSERT(first_branch_itr != _index.get<block_id>().end());
-   auto first_branch = *first_branch_itr;
+   auto first_branch = fetch_block(first);
+   FC_ASSERT(first_branch);
 
-   auto second_branch_itr = _index.get<block_id>().find(second);
-   FC_ASSERT(second_branch_itr != _index.get<block_id>().end());
-   auto second_branch = *second_branch_itr;
+   auto second_branch = fetch_block(second);
+   FC_ASSERT(second_branch);
 
 
    while( first_branch->data.block_num() > second_branch->data.block_num() )
@@ -237,7 +235,19 @@ void fork_database::set_head(shared_ptr<fork_item> h)
 
 void fork_database::remove(block_id_type id)
 {
-   _index.get<block_id>().erase(id);
+   auto slot = _slot( protocol::block_header::num_from_id(id) );
+   if( slot == nullptr )
+      return;
+
+   auto& items = _slots[ protocol::block_header::num_from_id(id) & ( _slots.size() - 1 ) ];
+   for( auto itr = items.begin(); itr != items.end(); ++itr )
+   {
+      if( (*itr)->id == id )
+      {
+         items.erase(itr);
+         return;
+      }
+   }
 }
 
 } } // futurepia::chain
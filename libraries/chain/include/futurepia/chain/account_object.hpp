@@ -143,13 +143,12 @@ namespace futurepia { namespace chain {
    };
 
    struct by_name;
-   struct by_last_post;
-   struct by_pia_balance;
-   struct by_snac_balance;
-   struct by_post_count;
 
    /**
     * @ingroup object_index
+    *
+    * Balance and activity rankings are not kept here, every adjust_*_balance would have to rebalance them.
+    * See the account_rank plugin.
     */
    typedef multi_index_container<
       account_object,
@@ -157,35 +156,7 @@ namespace futurepia { namespace chain {
          ordered_unique< tag< by_id >,
             member< account_object, account_id_type, &account_object::id > >,
          ordered_unique< tag< by_name >,
-            member< account_object, account_name_type, &account_object::name > >,
-         ordered_unique< tag< by_last_post >,
-            composite_key< account_object,
-               member< account_object, time_point_sec, &account_object::last_post >,
-               member< account_object, account_id_type, &account_object::id >
-            >,
-            composite_key_compare< std::greater< time_point_sec >, std::less< account_id_type > >
-         >,
-         ordered_unique< tag< by_pia_balance >,
-            composite_key< account_object,
-               member< account_object, asset, &account_object::balance >,
-               member< account_object, account_id_type, &account_object::id >
-            >,
-            composite_key_compare< std::greater< asset >, std::less< account_id_type > >
-         >,
-         ordered_unique< tag< by_snac_balance >,
-            composite_key< account_object,
-               member< account_object, asset, &account_object::snac_balance >,
-               member< account_object, account_id_type, &account_object::id >
-            >,
-            composite_key_compare< std::greater< asset >, std::less< account_id_type > >
-         >,
-         ordered_unique< tag< by_post_count >,
-            composite_key< account_object,
-               member< account_object, uint32_t, &account_object::post_count >,
-               member< account_object, account_id_type, &account_object::id >
-            >,
-            composite_key_compare< std::greater< uint32_t >, std::less< account_id_type > >
-         >
+            member< account_object, account_name_type, &account_object::name > >
       >,
       allocator< account_object >
    > account_index;
@@ -31,6 +31,12 @@ namespace futurepia { namespace chain {
     *
     * The main file is the only file that needs to persist. The index file can be reconstructed during a
     * linear scan of the main file.
+    *
+    * By default append() writes to the files directly and the caller decides when to flush. Once
+    * start_writer() has been called, append() only queues the block and a background thread writes every
+    * queued block in one batch, followed by a single flush and fsync (group commit). Queued blocks can still
+    * be read back through read_block_by_num(). persisted_block_num() is the highest block known to be on
+    * disk; everything above it may be lost on a crash and has to be replayed.
     */
 
    class block_log {
@@ -42,22 +48,50 @@ namespace futurepia { namespace chain {
          void close();
          bool is_open()const;
 
+         /// @return the file position of the block, or npos when it was queued for the writer
          uint64_t append( const signed_block& b );
+         /// Same as append( b ) for a caller that already computed the id of b
+         uint64_t append( const signed_block& b, const block_id_type& id );
+         /// Same as append( b, id ), the writer queues b itself instead of a copy of it
+         uint64_t append( const std::shared_ptr< const signed_block >& b, const block_id_type& id );
          void flush();
          std::pair< signed_block, uint64_t > read_block( uint64_t file_pos )const;
          optional< signed_block > read_block_by_num( uint32_t block_num )const;
 
+         /**
+          * Returns the packed form of up to count blocks starting at start_block_num, as stored in the file, with one
+          * read of the index and one of the block file. Stops early at the first block that is not in the log or
+          * once max_bytes would be exceeded, the first block is always returned.
+          */
+         std::vector< std::vector< char > > read_raw_blocks( uint32_t start_block_num, uint32_t count, uint64_t max_bytes )const;
+
          /**
           * Return offset of block in file, or block_log::npos if it does not exist.
           */
          uint64_t get_block_pos( uint32_t block_num ) const;
          signed_block read_head()const;
+         /// Last appended block, including blocks still waiting in the writer queue
          const optional< signed_block >& head()const;
 
+         /**
+          * Moves writes to a background thread. append() blocks once max_queue_size blocks are waiting.
+          */
+         void start_writer( size_t max_queue_size );
+         /// Writes out every queued block and joins the writer thread
+         void stop_writer();
+         bool has_writer()const;
+
+         /// Highest block number flushed to disk
+         uint32_t persisted_block_num()const;
+
          static const uint64_t npos = std::numeric_limits<uint64_t>::max();
 
       private:
          void construct_index();
+         void write_block( const signed_block& b );
+         std::pair< signed_block, uint64_t > read_block_unlocked( uint64_t file_pos )const;
+         uint64_t get_block_pos_unlocked( uint32_t block_num )const;
+         void writer_loop();
 
          std::unique_ptr<detail::block_log_impl> my;
    };
@@ -6,6 +6,7 @@
 #include <futurepia/chain/futurepia_object_types.hpp>
 
 #include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/mem_fun.hpp>
 
 namespace futurepia { namespace chain {
 
@@ -69,6 +70,9 @@ namespace futurepia { namespace chain {
          account_name_type bp_owner;
          price             snac_exchange_rate;
          time_point_sec    last_snac_exchange_update;
+
+         /// Only bobservers with a signing key can be scheduled
+         bool has_signing_key()const { return signing_key != public_key_type(); }
    };
 
    class bobserver_vote_object : public object< bobserver_vote_object_type, bobserver_vote_object >
@@ -118,6 +122,8 @@ namespace futurepia { namespace chain {
    struct by_name;
    struct by_is_bp;
    struct by_bp_owner;
+   struct by_schedule;
+   struct by_excepted;
    /**
     * @ingroup object_index
     */
@@ -145,6 +151,24 @@ namespace futurepia { namespace chain {
                member< bobserver_object, account_name_type, &bobserver_object::bp_owner >, 
                member< bobserver_object, bobserver_id_type, &bobserver_object::id > 
             >
+         >,
+         /// Schedule candidates, the block producers with a signing key then the other bobservers with one
+         ordered_unique< tag< by_schedule >,
+            composite_key< bobserver_object,
+               const_mem_fun< bobserver_object, bool, &bobserver_object::has_signing_key >,
+               member< bobserver_object, bool, &bobserver_object::is_bproducer >,
+               member< bobserver_object, account_name_type, &bobserver_object::account >
+            >,
+            composite_key_compare< std::greater< bool >, std::greater< bool >, std::less< account_name_type > >
+         >,
+         ordered_unique< tag< by_excepted >,
+            composite_key< bobserver_object,
+               member< bobserver_object, bool, &bobserver_object::is_excepted >,
+               const_mem_fun< bobserver_object, bool, &bobserver_object::has_signing_key >,
+               member< bobserver_object, bool, &bobserver_object::is_bproducer >,
+               member< bobserver_object, account_name_type, &bobserver_object::account >
+            >,
+            composite_key_compare< std::greater< bool >, std::greater< bool >, std::greater< bool >, std::less< account_name_type > >
          >
       >,
       allocator< bobserver_object >
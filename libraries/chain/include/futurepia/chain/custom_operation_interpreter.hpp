@@ -17,6 +17,13 @@ namespace futurepia { namespace protocol {
 
 namespace futurepia { namespace chain {
 
+struct custom_operation_cache_stats
+{
+   uint64_t hits = 0;
+   uint64_t misses = 0;
+   uint64_t entries = 0;
+};
+
 class custom_operation_interpreter
 {
    public:
@@ -24,6 +31,13 @@ class custom_operation_interpreter
       virtual void apply( const protocol::custom_json_hf2_operation& op ) = 0;
       virtual void apply( const protocol::custom_binary_operation & op ) = 0;
       virtual std::shared_ptr< graphene::schema::abstract_schema > get_operation_schema() = 0;
+      /// Inner operations of a packed custom operation, for display
+      virtual fc::variant unpack_binary_operation( const protocol::custom_binary_operation& op ) = 0;
+      virtual custom_operation_cache_stats get_cache_stats()const { return custom_operation_cache_stats(); }
+      /// Entries kept of parsed inner operations, 0 disables the cache
+      virtual void set_cache_size( size_t cache_size ) {}
 };
 
 } } // futurepia::chain
+
+FC_REFLECT( futurepia::chain::custom_operation_cache_stats, (hits)(misses)(entries) )
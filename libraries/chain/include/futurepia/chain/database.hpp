@@ -8,7 +8,9 @@
 #include <futurepia/chain/fork_database.hpp>
 #include <futurepia/chain/block_log.hpp>
 #include <futurepia/chain/operation_notification.hpp>
+#include <futurepia/chain/transaction_preprocessor.hpp>
 
+#include <futurepia/protocol/id_hash_counters.hpp>
 #include <futurepia/protocol/protocol.hpp>
 #include <futurepia/protocol/hardfork.hpp>
 
@@ -27,9 +29,11 @@ namespace futurepia { namespace chain {
    using futurepia::protocol::asset;
    using futurepia::protocol::asset_symbol_type;
    using futurepia::protocol::price;
+   using futurepia::protocol::id_hash_stats;
 
    class database_impl;
    class custom_operation_interpreter;
+   struct custom_operation_cache_stats;
 
    namespace util {
       struct comment_reward_context;
@@ -109,6 +113,13 @@ namespace futurepia { namespace chain {
          block_id_type              get_block_id_for_num( uint32_t block_num )const;
          optional<signed_block>     fetch_block_by_id( const block_id_type& id )const;
          optional<signed_block>     fetch_block_by_number( uint32_t num )const;
+
+         /**
+          * Packed form of up to count consecutive blocks of the current chain starting at start, irreversible blocks
+          * are copied out of the block log without being unpacked. Stops at the first missing block or once
+          * max_bytes would be exceeded, at least one block is returned when start exists.
+          */
+         vector< vector< char > >   fetch_raw_blocks( uint32_t start, uint32_t count, uint64_t max_bytes )const;
          const signed_transaction   get_recent_transaction( const transaction_id_type& trx_id )const;
          std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
 
@@ -186,6 +197,12 @@ namespace futurepia { namespace chain {
          void notify_pre_apply_operation( operation_notification& note );
          void notify_post_apply_operation( const operation_notification& note );
          void push_virtual_operation( const operation& op, bool force = false ); // vops are not needed for low mem. Force will push them on low mem.
+
+         /**
+          *  Returns the operation_object history plugins reference for the notified operation. The first call
+          *  for a notification creates it, later calls get it from the notification without an index lookup.
+          */
+         const operation_object& get_or_create_operation_object( const operation_notification& note );
          void notify_pre_apply_block( const signed_block& block );
          void notify_applied_block( const signed_block& block );
          void notify_on_pending_transaction( const signed_transaction& tx );
@@ -329,6 +346,17 @@ namespace futurepia { namespace chain {
          void initialize_evaluators();
          void set_custom_operation_interpreter( const std::string& id, std::shared_ptr< custom_operation_interpreter > registry );
          std::shared_ptr< custom_operation_interpreter > get_custom_evaluator( const std::string& id );
+         flat_map< std::string, custom_operation_cache_stats > get_custom_operation_cache_stats()const;
+
+         /**
+          *  Block and transaction ids hashed while the last block was pushed, including the pending transactions
+          *  that were popped and pushed again. Counted process wide, so hashing by other threads shows up as well.
+          */
+         const id_hash_stats& get_last_block_id_hash_stats()const { return _last_block_id_hashes; }
+
+         /// Id of the transaction being applied, default constructed outside of a transaction
+         const transaction_id_type& get_current_trx_id()const { return _current_trx_id; }
+         uint16_t get_current_op_in_trx()const { return _current_op_in_trx; }
 
          /// Reset the object graph in-memory
          void initialize_indexes();
@@ -362,6 +390,19 @@ namespace futurepia { namespace chain {
          const std::string& get_json_schema() const;
 
          void set_flush_interval( uint32_t flush_blocks );
+         /// Irreversible blocks queued for the background block log writer, 0 writes them synchronously. Takes effect on open.
+         void set_block_log_queue_size( uint32_t blocks );
+         /// Worker threads that validate and recover signatures of block transactions ahead of applying them, 0 does it inline
+         void set_transaction_check_threads( uint32_t threads );
+         /// Blocks kept in the flat get_ops_in_block table, older irreversible ones are served from operation_index. 0 disables the table.
+         void set_block_operations_depth( uint32_t blocks );
+         /// Parsed custom operations cached by each plugin interpreter, 0 disables the caches
+         void set_custom_operation_cache_size( uint32_t entries );
+         /**
+          *  Grows the shared memory file at the next block boundary once more than full_threshold of it is used,
+          *  by scale_rate of its current size. Both are in FUTUREPIA_100_PERCENT units, 0 disables growing.
+          */
+         void set_shared_file_growth( uint16_t full_threshold, uint16_t scale_rate );
          void show_free_memory( bool force );
 
          bool skip_transaction_delta_check = true;
@@ -377,9 +418,9 @@ namespace futurepia { namespace chain {
       private:
          optional< chainbase::database::session > _pending_tx_session;
 
-         void apply_block( const signed_block& next_block, uint32_t skip = skip_nothing );
+         void apply_block( const signed_block& next_block, const block_id_type& next_block_id, uint32_t skip = skip_nothing );
          void apply_transaction( const signed_transaction& trx, uint32_t skip = skip_nothing );
-         void _apply_block( const signed_block& next_block );
+         void _apply_block( const signed_block& next_block, const block_id_type& next_block_id );
          void _apply_transaction( const signed_transaction& trx );
          void apply_operation( const operation& op );
 
@@ -388,15 +429,17 @@ namespace futurepia { namespace chain {
          ///@{
 
          const bobserver_object& validate_block_header( uint32_t skip, const signed_block& next_block )const;
-         void create_block_summary(const signed_block& next_block);
+         void create_block_summary( const signed_block& next_block, const block_id_type& next_block_id );
+         void create_block_operations( uint32_t block_num );
 
          void clear_null_account_balance();
 
-         void update_global_dynamic_data( const signed_block& b );
+         void update_global_dynamic_data( const signed_block& b, const block_id_type& b_id );
          void update_signing_bobserver(const bobserver_object& signing_bobserver, const signed_block& new_block);
          void update_last_irreversible_block();
          void clear_expired_transactions();
          void process_header_extensions( const signed_block& next_block );
+         void check_shared_file_growth();
 
          void init_hardforks();
          void process_hardforks();
@@ -425,6 +468,8 @@ namespace futurepia { namespace chain {
          uint16_t                      _current_op_in_trx    = 0;
          uint16_t                      _current_virtual_op   = 0;
 
+         id_hash_stats                 _last_block_id_hashes;
+
          flat_map<uint32_t,block_id_type>  _checkpoints;
 
          node_property_object              _node_property_object;
@@ -432,8 +477,22 @@ namespace futurepia { namespace chain {
          uint32_t                      _flush_blocks = 0;
          uint32_t                      _next_flush_block = 0;
 
+         uint32_t                      _block_log_queue_size = 0;
+
+         uint32_t                      _block_operations_depth = FUTUREPIA_BLOCKS_PER_DAY;
+         optional< uint32_t >          _custom_operation_cache_size;
+
+         std::unique_ptr< transaction_preprocessor >   _trx_preprocessor;
+         /// Checks done ahead by _trx_preprocessor for the transaction about to be applied, consumed by _apply_transaction
+         const transaction_preprocessor::result*       _precomputed_trx = nullptr;
+
          uint32_t                      _last_free_gb_printed = 0;
 
+         uint16_t                      _shared_file_full_threshold = 0;
+         uint16_t                      _shared_file_scale_rate = 0;
+         /// After a failed grow the next attempt waits until this block
+         uint32_t                      _next_shared_file_grow_block = 0;
+
          flat_map< std::string, std::shared_ptr< custom_operation_interpreter > >   _custom_operation_interpreters;
          std::string                   _json_schema;
    };
@@ -1,24 +1,21 @@
 #pragma once
 #include <futurepia/protocol/block.hpp>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/mem_fun.hpp>
-
+#include <memory>
+#include <vector>
 
 namespace futurepia { namespace chain {
-   using boost::multi_index_container;
-   using namespace boost::multi_index;
-
    using futurepia::protocol::signed_block;
    using futurepia::protocol::block_id_type;
 
    struct fork_item
    {
       fork_item( signed_block d )
-      :num(d.block_num()),id(d.id()),data( std::move(d) ){}
+      :fork_item( std::make_shared< const signed_block >( std::move(d) ) ){}
+      fork_item( std::shared_ptr< const signed_block > d )
+      :fork_item( d, d->id() ){}
+      fork_item( std::shared_ptr< const signed_block > d, const block_id_type& block_id )
+      :num(d->block_num()),id(block_id),block( std::move(d) ),data( *block ){}
 
       block_id_type previous_id()const { return data.previous; }
 
@@ -30,7 +27,9 @@ namespace futurepia { namespace chain {
        */
       bool                  invalid = false;
       block_id_type         id;
-      signed_block          data;
+      /// Shared with the block log writer, so a block is copied once when it enters the node
+      std::shared_ptr< const signed_block > block;
+      const signed_block&   data;
    };
    typedef shared_ptr<fork_item> item_ptr;
 
@@ -44,6 +43,10 @@ namespace futurepia { namespace chain {
     *
     *  Every time a block is pushed into the fork DB the
     *  block with the highest block_num will be returned.
+    *
+    *  Blocks are kept in a ring of slots addressed by block number modulo its capacity, one slot holding the
+    *  blocks of every fork at that height. A block id starts with the block number, so lookups by id only
+    *  compare the ids in one slot, and moving the window forward clears the slots that fall out of it.
     */
    class fork_database
    {
@@ -66,6 +69,8 @@ namespace futurepia { namespace chain {
           *  @return the new head block ( the longest fork )
           */
          shared_ptr<fork_item>            push_block(const signed_block& b);
+         /// Same as push_block( b ) for a caller that already computed the id of b
+         shared_ptr<fork_item>            push_block(const signed_block& b, const block_id_type& id);
          shared_ptr<fork_item>            head()const { return _head; }
          void                             pop_block();
 
@@ -78,29 +83,21 @@ namespace futurepia { namespace chain {
          shared_ptr<fork_item>            walk_main_branch_to_num( uint32_t block_num )const;
          shared_ptr<fork_item>            fetch_block_on_main_branch_by_number( uint32_t block_num )const;
 
-         struct block_id;
-         struct block_num;
-         struct by_previous;
-         typedef multi_index_container<
-            item_ptr,
-            indexed_by<
-               hashed_unique<tag<block_id>, member<fork_item, block_id_type, &fork_item::id>, std::hash<fc::ripemd160>>,
-               hashed_non_unique<tag<by_previous>, const_mem_fun<fork_item, block_id_type, &fork_item::previous_id>, std::hash<fc::ripemd160>>,
-               ordered_non_unique<tag<block_num>, member<fork_item,uint32_t,&fork_item::num>>
-            >
-         > fork_multi_index_type;
-
          void set_max_size( uint32_t s );
 
       private:
-         /** @return a pointer to the newly pushed item */
          void _push_block(const item_ptr& b );
-         void _push_next(const item_ptr& newly_inserted);
+         void _insert(const item_ptr& item);
+         const vector<item_ptr>* _slot(uint32_t num)const;
 
          uint32_t                 _max_size = 1024;
 
-         fork_multi_index_type    _unlinked_index;
-         fork_multi_index_type    _index;
+         /// Slot of block n is n & ( _slots.size() - 1 ), the size is a power of two. Cleared slots keep their
+         /// storage, so the ring stops allocating once it has grown to the window.
+         vector< vector<item_ptr> > _slots;
+         /// Lowest and highest block number in the ring, _first_num is 0 while it is empty
+         uint32_t                 _first_num = 0;
+         uint32_t                 _last_num = 0;
          shared_ptr<fork_item>    _head;
    };
 
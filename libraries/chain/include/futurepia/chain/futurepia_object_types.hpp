@@ -62,7 +62,8 @@ enum object_type
    comment_betting_object_type,
    fund_withdraw_object_type,
    exchange_withdraw_object_type,
-   dapp_reward_fund_object_type
+   dapp_reward_fund_object_type,
+   block_operations_object_type
 };
 
 class dynamic_global_property_object;
@@ -90,6 +91,7 @@ class comment_betting_object;
 class fund_withdraw_object;
 class exchange_withdraw_object;
 class dapp_reward_fund_object;
+class block_operations_object;
 
 typedef oid< dynamic_global_property_object         > dynamic_global_property_id_type;
 typedef oid< account_object                         > account_id_type;
@@ -116,6 +118,7 @@ typedef oid< comment_betting_object                 > comment_betting_id_type;
 typedef oid< fund_withdraw_object                   > fund_withdraw_id_type;
 typedef oid< exchange_withdraw_object               > exchange_withdraw_id_type;
 typedef oid< dapp_reward_fund_object                > dapp_reward_fund_id_type;
+typedef oid< block_operations_object                > block_operations_id_type;
 
 enum bandwidth_type
 {
@@ -221,6 +224,7 @@ FC_REFLECT_ENUM( futurepia::chain::object_type,
                  (fund_withdraw_object_type)
                  (exchange_withdraw_object_type)
                  (dapp_reward_fund_object_type)
+                 (block_operations_object_type)
                )
 
 FC_REFLECT_TYPENAME( futurepia::chain::shared_string )
@@ -12,6 +12,9 @@
 
 #include <fc/variant.hpp>
 
+#include <deque>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,13 +22,43 @@ namespace futurepia { namespace chain {
 
 class database;
 
+/**
+ *  Applies the operations of a plugin carried by custom_json, custom_json_hf2 and custom_binary operations.
+ *
+ *  A transaction is applied when it enters the mempool, each time the pending set is re-applied and once more
+ *  in its block. The parsed inner operations are kept by transaction id and operation index, so the JSON is only
+ *  parsed the first time. The cache is bounded and drops the oldest entries first, the default size covers the
+ *  transactions a node keeps in the mempool and fork database under normal load. Set by custom-op-cache-size.
+ */
 template< typename CustomOperationType >
 class generic_custom_operation_interpreter
    : public custom_operation_interpreter, public evaluator_registry< CustomOperationType >
 {
    public:
+      typedef std::vector< CustomOperationType >                   operation_vector;
+      typedef std::shared_ptr< const operation_vector >            operation_vector_ptr;
+
+      static const size_t default_cache_size = 10000;
+
       generic_custom_operation_interpreter( database& db ) : evaluator_registry< CustomOperationType >(db) {}
 
+      virtual void set_cache_size( size_t cache_size ) override
+      {
+         _cache_size = cache_size;
+         while( _cache_order.size() > _cache_size )
+         {
+            _cache.erase( _cache_order.front() );
+            _cache_order.pop_front();
+         }
+      }
+
+      virtual custom_operation_cache_stats get_cache_stats()const override
+      {
+         custom_operation_cache_stats stats = _stats;
+         stats.entries = _cache.size();
+         return stats;
+      }
+
       void apply_operations( const vector< CustomOperationType >& custom_operations, const operation& outer_o )
       {
          auto plugin_session = this->_db.start_undo_session( true );
@@ -67,10 +100,7 @@ class generic_custom_operation_interpreter
       {
          try
          {
-            std::vector< CustomOperationType > custom_operations;
-            
-            get_inner_operation( outer_o, custom_operations );
-            apply_operations( custom_operations, operation( outer_o ) );
+            apply_operations( *get_cached_inner_operation( outer_o ), operation( outer_o ) );
          } FC_CAPTURE_AND_RETHROW( (outer_o) )
       }
 
@@ -81,10 +111,7 @@ class generic_custom_operation_interpreter
             if( !this->_db.has_hardfork( FUTUREPIA_HARDFORK_0_2 ) ){
                FC_ASSERT( false, "custom_json_hf2_operation do not use in version 0.1.0." );
             }
-            std::vector< CustomOperationType > custom_operations;
-            
-            get_inner_operation( outer_o, custom_operations );
-            apply_operations( custom_operations, operation( outer_o ) );
+            apply_operations( *get_cached_inner_operation( outer_o ), operation( outer_o ) );
          } FC_CAPTURE_AND_RETHROW( (outer_o) )
       }
 
@@ -92,10 +119,7 @@ class generic_custom_operation_interpreter
       {
          try
          {
-            std::vector< CustomOperationType > custom_operations;
-
-            get_inner_operation( outer_o, custom_operations );
-            apply_operations( custom_operations, operation( outer_o ) );
+            apply_operations( *get_cached_inner_operation( outer_o ), operation( outer_o ) );
          }
          FC_CAPTURE_AND_RETHROW( (outer_o) )
       }
@@ -105,7 +129,55 @@ class generic_custom_operation_interpreter
          return graphene::schema::get_schema_for_type< CustomOperationType >();
       }
 
+      virtual fc::variant unpack_binary_operation( const protocol::custom_binary_operation& outer_o ) override
+      {
+         try
+         {
+            operation_vector custom_operations;
+            get_inner_operation( outer_o, custom_operations );
+            return fc::variant( custom_operations );
+         }
+         FC_CAPTURE_AND_RETHROW( (outer_o) )
+      }
+
    private:
+      typedef std::pair< transaction_id_type, uint16_t > cache_key;
+
+      template< typename OuterOperationType >
+      operation_vector_ptr get_cached_inner_operation( const OuterOperationType& outer_op )
+      {
+         const transaction_id_type& trx_id = this->_db.get_current_trx_id();
+         if( _cache_size == 0 || trx_id == transaction_id_type() )
+         {
+            auto custom_operations = std::make_shared< operation_vector >();
+            get_inner_operation( outer_op, *custom_operations );
+            return custom_operations;
+         }
+
+         // The transaction id covers the operation contents, so the same key always parses to the same operations
+         cache_key key( trx_id, this->_db.get_current_op_in_trx() );
+         auto itr = _cache.find( key );
+         if( itr != _cache.end() )
+         {
+            ++_stats.hits;
+            return itr->second;
+         }
+
+         ++_stats.misses;
+         auto custom_operations = std::make_shared< operation_vector >();
+         get_inner_operation( outer_op, *custom_operations );
+
+         if( _cache_order.size() >= _cache_size )
+         {
+            _cache.erase( _cache_order.front() );
+            _cache_order.pop_front();
+         }
+
+         _cache.emplace( key, custom_operations );
+         _cache_order.push_back( key );
+         return custom_operations;
+      }
+
       void get_inner_operation( const protocol::custom_json_operation& outer_op, std::vector< CustomOperationType >& custom_operations )
       {
          fc::variant v = fc::json::from_string( outer_op.json );
@@ -153,6 +225,11 @@ class generic_custom_operation_interpreter
             custom_operations.push_back( fc::raw::unpack< CustomOperationType >( outer_op.data ) );
          }
       }
+
+      size_t                                                   _cache_size = default_cache_size;
+      std::map< cache_key, operation_vector_ptr >              _cache;
+      std::deque< cache_key >                                  _cache_order;
+      custom_operation_cache_stats                             _stats;
 };
 
 } }
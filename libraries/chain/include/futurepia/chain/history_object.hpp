@@ -95,6 +95,58 @@ namespace futurepia { namespace chain {
       >,
       allocator< account_history_object >
    > account_history_index;
+
+   /// Location fields of an operation_object, as stored in block_operations_object::packed_ops
+   struct block_operation_header
+   {
+      transaction_id_type  trx_id;
+      uint32_t             trx_in_block = 0;
+      uint16_t             op_in_trx = 0;
+      uint64_t             virtual_op = 0;
+      time_point_sec       timestamp;
+   };
+
+   /**
+    *  The operations of one block in a flat layout, built from operation_index when the next block is applied so it
+    *  includes the virtual operations pushed by applied_block handlers. Tables of irreversible blocks older than
+    *  database::set_block_operations_depth are removed again.
+    *
+    *  Entry i of packed_ops spans [offsets[i], offsets[i+1]) and holds a block_operation_header followed by the
+    *  serialized operation. Bit i of virtual_ops is set if entry i is a virtual operation, so entries can be
+    *  selected without unpacking the ones that are skipped.
+    */
+   class block_operations_object : public object< block_operations_object_type, block_operations_object >
+   {
+      block_operations_object() = delete;
+
+      public:
+         template< typename Constructor, typename Allocator >
+         block_operations_object( Constructor&& c, allocator< Allocator > a )
+            :offsets( a.get_segment_manager() ), virtual_ops( a.get_segment_manager() ), packed_ops( a.get_segment_manager() )
+         {
+            c( *this );
+         }
+
+         id_type              id;
+
+         uint32_t             block = 0;
+         bip::vector< uint32_t, allocator< uint32_t > > offsets;
+         bip::vector< uint64_t, allocator< uint64_t > > virtual_ops;
+         buffer_type          packed_ops;
+
+         uint32_t size()const { return offsets.size() ? offsets.size() - 1 : 0; }
+         bool is_virtual( uint32_t i )const { return virtual_ops[ i / 64 ] & ( uint64_t( 1 ) << ( i % 64 ) ); }
+   };
+
+   struct by_block;
+   typedef multi_index_container<
+      block_operations_object,
+      indexed_by<
+         ordered_unique< tag< by_id >, member< block_operations_object, block_operations_id_type, &block_operations_object::id > >,
+         ordered_unique< tag< by_block >, member< block_operations_object, uint32_t, &block_operations_object::block > >
+      >,
+      allocator< block_operations_object >
+   > block_operations_index;
 } }
 
 FC_REFLECT( futurepia::chain::operation_object, (id)(trx_id)(block)(trx_in_block)(op_in_trx)(virtual_op)(timestamp)(serialized_op) )
@@ -102,3 +154,8 @@ CHAINBASE_SET_INDEX_TYPE( futurepia::chain::operation_object, futurepia::chain::
 
 FC_REFLECT( futurepia::chain::account_history_object, (id)(account)(sequence)(op) )
 CHAINBASE_SET_INDEX_TYPE( futurepia::chain::account_history_object, futurepia::chain::account_history_index )
+
+FC_REFLECT( futurepia::chain::block_operation_header, (trx_id)(trx_in_block)(op_in_trx)(virtual_op)(timestamp) )
+
+FC_REFLECT( futurepia::chain::block_operations_object, (id)(block)(offsets)(virtual_ops)(packed_ops) )
+CHAINBASE_SET_INDEX_TYPE( futurepia::chain::block_operations_object, futurepia::chain::block_operations_index )
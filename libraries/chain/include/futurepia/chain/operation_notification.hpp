@@ -16,6 +16,9 @@ struct operation_notification
    uint16_t            op_in_trx = 0;
    uint64_t            virtual_op = 0;
    const operation&    op;
+
+   /// operation_object of this operation, set by the first history plugin that stores it so the others reuse it
+   mutable const operation_object* history_object = nullptr;
 };
 
 } }
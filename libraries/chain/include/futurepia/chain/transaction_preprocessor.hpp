@@ -0,0 +1,77 @@
+#pragma once
+
+#include <futurepia/protocol/transaction.hpp>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <exception>
+#include <vector>
+
+namespace futurepia { namespace chain {
+
+using futurepia::protocol::chain_id_type;
+using futurepia::protocol::public_key_type;
+using futurepia::protocol::signed_transaction;
+using futurepia::protocol::transaction_id_type;
+
+/**
+ *  Runs the state independent checks of the transactions in a block on a pool of worker threads: operation
+ *  validation, the transaction id and recovery of the signing keys.
+ *
+ *  The database still applies the transactions one at a time in block order and rethrows a failed check when it
+ *  reaches that transaction, so the outcome of a block does not depend on the number of threads.
+ */
+class transaction_preprocessor
+{
+   public:
+      struct result
+      {
+         transaction_id_type              id;
+         fc::flat_set< public_key_type >  signature_keys;
+
+         bool                             validated = false;
+         std::exception_ptr               validate_error;
+         bool                             keys_recovered = false;
+         std::exception_ptr               signature_error;
+      };
+
+      explicit transaction_preprocessor( uint32_t threads );
+      ~transaction_preprocessor();
+
+      uint32_t thread_count()const { return _thread_count; }
+
+      /**
+       *  Checks every transaction of trxs and blocks until all of them are done, the calling thread takes part.
+       *  The results stay valid until the next call.
+       */
+      void process( const std::vector< signed_transaction >& trxs, const chain_id_type& chain_id, bool validate, bool recover_keys );
+
+      const result& get( size_t trx_in_block )const { return _results[ trx_in_block ]; }
+
+   private:
+      void worker_loop();
+      void run_jobs();
+      void check( const signed_transaction& trx, result& r )const;
+
+      uint32_t                                  _thread_count = 0;
+      boost::thread_group                       _workers;
+
+      boost::mutex                              _mutex;
+      boost::condition_variable                 _work_cv;
+      boost::condition_variable                 _done_cv;
+      bool                                      _stopping = false;
+      uint64_t                                  _generation = 0;
+      uint32_t                                  _active = 0;
+
+      const std::vector< signed_transaction >*  _trxs = nullptr;
+      chain_id_type                             _chain_id;
+      bool                                      _validate = false;
+      bool                                      _recover_keys = false;
+      size_t                                    _next = 0;
+      size_t                                    _done = 0;
+      std::vector< result >                     _results;
+};
+
+} } // futurepia::chain
@@ -0,0 +1,126 @@
+#include <futurepia/chain/transaction_preprocessor.hpp>
+
+#include <fc/thread/scoped_lock.hpp>
+
+namespace futurepia { namespace chain {
+
+transaction_preprocessor::transaction_preprocessor( uint32_t threads )
+   : _thread_count( threads )
+{
+   for( uint32_t i = 0; i < threads; ++i )
+      _workers.create_thread( [this]() { worker_loop(); } );
+}
+
+transaction_preprocessor::~transaction_preprocessor()
+{
+   {
+      fc::scoped_lock< boost::mutex > lock( _mutex );
+      _stopping = true;
+   }
+   _work_cv.notify_all();
+   _workers.join_all();
+}
+
+void transaction_preprocessor::process( const std::vector< signed_transaction >& trxs, const chain_id_type& chain_id, bool validate, bool recover_keys )
+{
+   {
+      boost::unique_lock< boost::mutex > lock( _mutex );
+      // A worker that woke up late for the previous block may still be looking at its transactions
+      _done_cv.wait( lock, [&]() { return _active == 0; } );
+
+      _trxs = &trxs;
+      _chain_id = chain_id;
+      _validate = validate;
+      _recover_keys = recover_keys;
+      _next = 0;
+      _done = 0;
+      _results.clear();
+      _results.resize( trxs.size() );
+      ++_generation;
+      ++_active;
+   }
+   _work_cv.notify_all();
+
+   run_jobs();
+
+   boost::unique_lock< boost::mutex > lock( _mutex );
+   _done_cv.wait( lock, [&]() { return _done == _trxs->size() && _active == 0; } );
+   _trxs = nullptr;
+}
+
+void transaction_preprocessor::worker_loop()
+{
+   uint64_t generation = 0;
+
+   while( true )
+   {
+      {
+         boost::unique_lock< boost::mutex > lock( _mutex );
+         _work_cv.wait( lock, [&]() { return _stopping || _generation != generation; } );
+         if( _stopping )
+            return;
+
+         generation = _generation;
+         ++_active;
+      }
+
+      run_jobs();
+   }
+}
+
+void transaction_preprocessor::run_jobs()
+{
+   while( true )
+   {
+      size_t i;
+      {
+         fc::scoped_lock< boost::mutex > lock( _mutex );
+         if( _trxs == nullptr || _next >= _trxs->size() )
+         {
+            --_active;
+            break;
+         }
+         i = _next++;
+      }
+
+      check( ( *_trxs )[ i ], _results[ i ] );
+
+      fc::scoped_lock< boost::mutex > lock( _mutex );
+      ++_done;
+   }
+
+   _done_cv.notify_all();
+}
+
+void transaction_preprocessor::check( const signed_transaction& trx, result& r )const
+{
+   r.id = trx.id();
+
+   if( _validate )
+   {
+      r.validated = true;
+      try
+      {
+         trx.validate();
+      }
+      catch( ... )
+      {
+         r.validate_error = std::current_exception();
+      }
+   }
+
+   if( _recover_keys )
+   {
+      r.keys_recovered = true;
+      try
+      {
+         r.signature_keys = trx.get_signature_keys( _chain_id );
+      }
+      catch( ... )
+      {
+         r.signature_error = std::current_exception();
+      }
+   }
+}
+
+} } // futurepia::chain
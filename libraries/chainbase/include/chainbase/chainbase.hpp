@@ -594,6 +594,9 @@ namespace chainbase {
          void add_index_extension( std::shared_ptr< index_extension > ext )  { _extensions.push_back( ext ); }
          const index_extensions& get_index_extensions()const  { return _extensions; }
          void* get()const { return _idx_ptr; }
+
+         /// Points the wrapper at the index after the segment was mapped at a different address
+         virtual void rebind( void* i ) { _idx_ptr = i; }
       private:
          void*              _idx_ptr;
          index_extensions   _extensions;
@@ -602,23 +605,25 @@ namespace chainbase {
    template<typename BaseIndex>
    class index_impl : public abstract_index {
       public:
-         index_impl( BaseIndex& base ):abstract_index( &base ),_base(base){}
+         index_impl( BaseIndex& base ):abstract_index( &base ),_base(&base){}
 
          virtual unique_ptr<abstract_session> start_undo_session( bool enabled ) override {
-            return unique_ptr<abstract_session>( new session_impl<typename BaseIndex::session>( _base.start_undo_session( enabled ) ) );
+            return unique_ptr<abstract_session>( new session_impl<typename BaseIndex::session>( _base->start_undo_session( enabled ) ) );
          }
 
-         virtual void     set_revision( int64_t revision ) override { _base.set_revision( revision ); }
-         virtual int64_t  revision()const  override { return _base.revision(); }
-         virtual void     undo()const  override { _base.undo(); }
-         virtual void     squash()const  override { _base.squash(); }
-         virtual void     commit( int64_t revision )const  override { _base.commit(revision); }
-         virtual void     undo_all() const override {_base.undo_all(); }
+         virtual void     set_revision( int64_t revision ) override { _base->set_revision( revision ); }
+         virtual int64_t  revision()const  override { return _base->revision(); }
+         virtual void     undo()const  override { _base->undo(); }
+         virtual void     squash()const  override { _base->squash(); }
+         virtual void     commit( int64_t revision )const  override { _base->commit(revision); }
+         virtual void     undo_all() const override {_base->undo_all(); }
          virtual uint32_t type_id()const override { return BaseIndex::value_type::type_id; }
 
-         virtual void     remove_object( int64_t id ) override { return _base.remove_object( id ); }
+         virtual void     remove_object( int64_t id ) override { return _base->remove_object( id ); }
+
+         virtual void     rebind( void* i ) override { _base = static_cast< BaseIndex* >( i ); abstract_index::rebind( i ); }
       private:
-         BaseIndex& _base;
+         BaseIndex* _base;
    };
 
    template<typename IndexType>
@@ -654,6 +659,29 @@ namespace chainbase {
             return _current_lock;
          }
 
+         /**
+          *  Write locks every mutex but the current one, which the caller already holds, so that no reader that a
+          *  lock rotation left behind is still running. Gives up and releases them if one is not free by deadline.
+          */
+         bool lock_others( std::vector< write_lock >& locks, const boost::posix_time::ptime& deadline )
+         {
+            uint32_t current = _current_lock % CHAINBASE_NUM_RW_LOCKS;
+            for( uint32_t i = 0; i < CHAINBASE_NUM_RW_LOCKS; ++i )
+            {
+               if( i == current )
+                  continue;
+
+               write_lock lock( _locks[ i ], boost::defer_lock_t() );
+               if( !lock.timed_lock( deadline ) )
+               {
+                  locks.clear();
+                  return false;
+               }
+               locks.push_back( std::move( lock ) );
+            }
+            return true;
+         }
+
       private:
          std::array< read_write_mutex, CHAINBASE_NUM_RW_LOCKS >     _locks;
          std::atomic< uint32_t >                                    _current_lock;
@@ -671,10 +699,47 @@ namespace chainbase {
             read_write    = 1
          };
 
+         /// Outcome of grow()
+         enum grow_result {
+            grow_done,              ///< the file was grown and mapped again
+            grow_readers_active,    ///< readers still held another lock, nothing was changed
+            grow_failed             ///< the file could not be grown, e.g. the disk is full, and is mapped at its old size
+         };
+
+         /**
+          *  How the shared memory segment is mapped, see set_map_options(). Huge pages need the segment to live on
+          *  a hugetlbfs mount or on tmpfs with transparent huge pages enabled for shmem, point the shared memory
+          *  directory there. All of these are Linux only and are ignored elsewhere.
+          */
+         enum map_flags {
+            map_default      = 0,
+            map_hugepage     = 1 << 0,   ///< madvise( MADV_HUGEPAGE ), back the segment with transparent huge pages
+            map_random       = 1 << 1,   ///< madvise( MADV_RANDOM ), no read-ahead for tree lookups
+            map_willneed     = 1 << 2,   ///< madvise( MADV_WILLNEED ), start reading the file in the background
+            map_populate     = 1 << 3    ///< fault in every page of the segment before returning from open
+         };
+
          database():_session_signal( std::make_shared< session_signal >() ){}
 
+         /**
+          *  Sets the map_flags and the NUMA node the segment pages are bound to, -1 for no binding. Binding only
+          *  applies to pages of tmpfs and hugetlbfs files. Takes effect on the next open() or grow().
+          */
+         void set_map_options( uint32_t flags, int32_t numa_node = -1 ) { _map_flags = flags; _numa_node = numa_node; }
+
          void open( const bfs::path& dir, uint32_t write = read_only, uint64_t shared_file_size = 0 );
          void close();
+
+         /**
+          *  Grows the shared memory file by extra_bytes and maps it again, which may move it to a different address.
+          *  Every reference into the segment, including objects, iterators and open undo sessions, is invalidated,
+          *  so this must be called with the write lock held and no session open. Indexes and undo history stay intact.
+          *
+          *  Readers left on an older lock by a write lock timeout could still be using the segment, so every other
+          *  lock is taken too. Returns grow_readers_active without growing if one of them is still held after
+          *  wait_micro.
+          */
+         grow_result grow( uint64_t extra_bytes, uint64_t wait_micro = 0 );
          void flush();
          void wipe( const bfs::path& dir );
          void set_require_locking( bool enable_require_locking );
@@ -730,6 +795,10 @@ namespace chainbase {
 
                void undo()
                {
+                  // Nothing left to undo once the session was pushed or squashed
+                  if( _index_sessions.empty() )
+                     return;
+
                   for( auto& i : _index_sessions ) i->undo();
                   _index_sessions.clear();
                   if( _session_signal ) _session_signal->notify_on_undo_session( _revision );
@@ -805,6 +874,11 @@ namespace chainbase {
             return _segment->get_segment_manager()->get_free_memory();
          }
 
+         size_t get_shared_file_size()const
+         {
+            return _segment->get_size();
+         }
+
          template<typename MultiIndexType>
          bool has_index()const
          {
@@ -1007,6 +1081,8 @@ namespace chainbase {
          std::shared_ptr< session_signal > get_session_signal() { return _session_signal; }
 
       private:
+         void apply_map_options();
+
          unique_ptr<bip::managed_mapped_file>                        _segment;
          unique_ptr<bip::managed_mapped_file>                        _meta;
          read_write_mutex_manager*                                   _rw_manager = nullptr;
@@ -1025,6 +1101,9 @@ namespace chainbase {
 
          bfs::path                                                   _data_dir;
 
+         uint32_t                                                    _map_flags = map_default;
+         int32_t                                                     _numa_node = -1;
+
          int32_t                                                     _read_lock_count = 0;
          int32_t                                                     _write_lock_count = 0;
          bool                                                        _enable_require_locking = false;
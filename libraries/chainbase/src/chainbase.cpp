@@ -3,6 +3,22 @@
 
 #include <iostream>
 
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE ( 1 << 1 )
+#endif
+#endif
+
 namespace chainbase {
    struct environment_check {
       environment_check() {
@@ -111,6 +127,86 @@ namespace chainbase {
          if( !_flock.try_lock() )
             BOOST_THROW_EXCEPTION( std::runtime_error( "could not gain write access to the shared memory file" ) );
       }
+
+      apply_map_options();
+   }
+
+   void database::apply_map_options()
+   {
+#ifdef __linux__
+      char* base = static_cast< char* >( _segment->get_address() );
+      size_t size = _segment->get_size();
+
+      // The mapping is page aligned, madvise fails on a partial page at the end
+      size_t page_size = sysconf( _SC_PAGESIZE );
+      size -= size % page_size;
+
+      auto advise = [&]( int advice, const char* name )
+      {
+         if( madvise( base, size, advice ) != 0 )
+            std::cerr << "madvise( " << name << " ) on shared memory failed: " << strerror( errno ) << std::endl;
+      };
+
+#ifdef MADV_HUGEPAGE
+      if( _map_flags & map_hugepage )
+         advise( MADV_HUGEPAGE, "MADV_HUGEPAGE" );
+#endif
+      if( _map_flags & map_random )
+         advise( MADV_RANDOM, "MADV_RANDOM" );
+      if( _map_flags & map_willneed )
+         advise( MADV_WILLNEED, "MADV_WILLNEED" );
+
+      if( _numa_node >= 0 && _numa_node < 64 )
+      {
+         unsigned long mask = 1ul << _numa_node;
+         if( syscall( SYS_mbind, base, size, MPOL_BIND, &mask, sizeof( mask ) * 8, MPOL_MF_MOVE ) != 0 )
+            std::cerr << "binding shared memory to NUMA node " << _numa_node << " failed: " << strerror( errno ) << std::endl;
+      }
+
+      if( _map_flags & map_populate )
+      {
+         // Reading is enough to fault in the page cache and huge pages, writes only add a cheap minor fault
+         volatile char sink = 0;
+         for( size_t offset = 0; offset < size; offset += page_size )
+            sink += base[ offset ];
+         (void)sink;
+      }
+#endif
+   }
+
+   database::grow_result database::grow( uint64_t extra_bytes, uint64_t wait_micro )
+   {
+      if( _read_only )
+         BOOST_THROW_EXCEPTION( std::logic_error( "cannot grow a read only database" ) );
+
+      vector< write_lock > other_locks;
+      if( !_rw_manager->lock_others( other_locks,
+            boost::posix_time::microsec_clock::universal_time() + boost::posix_time::microseconds( wait_micro ) ) )
+         return grow_readers_active;
+
+      auto abs_path = bfs::absolute( _data_dir / "shared_memory.bin" );
+
+      // Index wrappers keep raw pointers into the segment, remember where they live relative to its base
+      const char* old_base = static_cast< const char* >( _segment->get_address() );
+      vector< std::ptrdiff_t > offsets;
+      offsets.reserve( _index_list.size() );
+      for( const auto& item : _index_list )
+         offsets.push_back( static_cast< const char* >( item->get() ) - old_base );
+
+      _segment->flush();
+      _segment.reset();
+
+      bool grown = bip::managed_mapped_file::grow( abs_path.generic_string().c_str(), extra_bytes );
+
+      _segment.reset( new bip::managed_mapped_file( bip::open_only, abs_path.generic_string().c_str() ) );
+
+      char* new_base = static_cast< char* >( _segment->get_address() );
+      for( size_t i = 0; i < _index_list.size(); ++i )
+         _index_list[i]->rebind( new_base + offsets[i] );
+
+      apply_map_options();
+
+      return grown ? grow_done : grow_failed;
    }
 
    void database::flush() {
@@ -10,12 +10,7 @@ namespace fc {
        template<typename Stream, typename T>
        inline void pack( Stream& s, const flat_set<T>& value ) {
          pack( s, unsigned_int((uint32_t)value.size()) );
-         auto itr = value.begin();
-         auto end = value.end();
-         while( itr != end ) {
-           fc::raw::pack( s, *itr );
-           ++itr;
-         }
+         detail::pack_elements( s, value );
        }
        template<typename Stream, typename T>
        inline void unpack( Stream& s, flat_set<T>& value ) {
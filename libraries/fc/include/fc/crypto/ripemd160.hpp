@@ -46,7 +46,7 @@ class ripemd160
 
       private:
         struct      impl;
-        fc::fwd<impl,96> my;
+        fc::fwd<impl,232> my;
     };
 
     template<typename T>
@@ -80,6 +80,8 @@ class ripemd160
 
   template<> struct get_typename<uint160_t>    { static const char* name()  { return "uint160_t";  } };
 
+  namespace raw { template<> struct is_memcpy_packable<ripemd160> : std::true_type {}; }
+
 } // namespace fc
 
 namespace std
@@ -43,7 +43,7 @@ class sha224
 
       private:
         struct      impl;
-        fc::fwd<impl,112> my;
+        fc::fwd<impl,248> my;
     };
 
     template<typename T>
@@ -74,6 +74,8 @@ class sha224
   void to_variant( const sha224& bi, variant& v );
   void from_variant( const variant& v, sha224& bi );
 
+  namespace raw { template<> struct is_memcpy_packable<sha224> : std::true_type {}; }
+
 } // fc
 namespace std
 {
@@ -24,6 +24,13 @@ class sha256
     static sha256 hash( const string& );
     static sha256 hash( const sha256& );
 
+    /**
+     *  Hashes count messages of message_size bytes each, stored back to back at data, into out[0..count).
+     *  out may point at data as long as message_size >= sizeof(sha256), every message is read before its
+     *  digest is written.
+     */
+    static void hash_batch( const char* data, uint32_t message_size, size_t count, sha256* out );
+
     template<typename T>
     static sha256 hash( const T& t ) 
     { 
@@ -45,7 +52,7 @@ class sha256
 
       private:
         struct      impl;
-        fc::fwd<impl,112> my;
+        fc::fwd<impl,248> my;
     };
 
     template<typename T>
@@ -106,6 +113,8 @@ class sha256
 
   uint64_t hash64(const char* buf, size_t len);    
 
+  namespace raw { template<> struct is_memcpy_packable<sha256> : std::true_type {}; }
+
 } // fc
 namespace std
 {
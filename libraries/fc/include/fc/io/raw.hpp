@@ -475,15 +475,49 @@ namespace fc {
       }
     }
 
+    namespace detail {
+      // Container must keep its elements contiguous, as std::vector and flat_set do
+      template<typename Stream, typename Container>
+      inline typename std::enable_if< is_memcpy_packable<typename Container::value_type>::value >::type
+      pack_elements( Stream& s, const Container& value ) {
+        if( value.size() )
+          s.write( (const char*)&*value.begin(), value.size() * sizeof(typename Container::value_type) );
+      }
+
+      template<typename Stream, typename Container>
+      inline typename std::enable_if< !is_memcpy_packable<typename Container::value_type>::value >::type
+      pack_elements( Stream& s, const Container& value ) {
+        auto itr = value.begin();
+        auto end = value.end();
+        while( itr != end ) {
+          fc::raw::pack( s, *itr );
+          ++itr;
+        }
+      }
+
+      template<typename Stream, typename T>
+      inline typename std::enable_if< is_memcpy_packable<T>::value >::type
+      unpack_elements( Stream& s, std::vector<T>& value ) {
+        if( value.size() )
+          s.read( (char*)value.data(), value.size() * sizeof(T) );
+      }
+
+      template<typename Stream, typename T>
+      inline typename std::enable_if< !is_memcpy_packable<T>::value >::type
+      unpack_elements( Stream& s, std::vector<T>& value ) {
+        auto itr = value.begin();
+        auto end = value.end();
+        while( itr != end ) {
+          fc::raw::unpack( s, *itr );
+          ++itr;
+        }
+      }
+    }
+
     template<typename Stream, typename T>
     inline void pack( Stream& s, const std::vector<T>& value ) {
       fc::raw::pack( s, unsigned_int((uint32_t)value.size()) );
-      auto itr = value.begin();
-      auto end = value.end();
-      while( itr != end ) {
-        fc::raw::pack( s, *itr );
-        ++itr;
-      }
+      detail::pack_elements( s, value );
     }
 
     template<typename Stream, typename T>
@@ -491,12 +525,7 @@ namespace fc {
       unsigned_int size; fc::raw::unpack( s, size );
       FC_ASSERT( size.value*sizeof(T) < MAX_ARRAY_ALLOC_SIZE );
       value.resize(size.value);
-      auto itr = value.begin();
-      auto end = value.end();
-      while( itr != end ) {
-        fc::raw::unpack( s, *itr );
-        ++itr;
-      }
+      detail::unpack_elements( s, value );
     }
 
     template<typename Stream, typename T>
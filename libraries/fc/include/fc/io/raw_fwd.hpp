@@ -10,6 +10,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <set>
+#include <type_traits>
 
 #define MAX_ARRAY_ALLOC_SIZE (1024*1024*10*30) 
 
@@ -121,4 +122,22 @@ namespace fc {
     template<typename T> inline T unpack( const std::vector<char>& s );
     template<typename T> inline T unpack( const char* d, uint32_t s );
     template<typename T> inline void unpack( const char* d, uint32_t s, T& v );
+
+    /**
+     *  True when the packed form of T is exactly its in memory representation, so a contiguous run of T packs and
+     *  unpacks with a single write or read. bool is left out because unpacking it validates the value.
+     *  Specialize it next to the pack overloads of types that qualify.
+     */
+    template<typename T> struct is_memcpy_packable
+       : std::integral_constant< bool, std::is_arithmetic<T>::value && !std::is_same<T,bool>::value > {};
+    template<typename T, size_t N> struct is_memcpy_packable< fc::array<T,N> > : is_memcpy_packable<T> {};
+
+    namespace detail {
+       template<typename Stream, typename Container>
+       inline typename std::enable_if< is_memcpy_packable<typename Container::value_type>::value >::type
+       pack_elements( Stream& s, const Container& value );
+       template<typename Stream, typename Container>
+       inline typename std::enable_if< !is_memcpy_packable<typename Container::value_type>::value >::type
+       pack_elements( Stream& s, const Container& value );
+    }
 } }
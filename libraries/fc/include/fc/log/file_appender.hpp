@@ -18,11 +18,21 @@ class file_appender : public appender {
             bool                               rotate = false;
             microseconds                       rotation_interval;
             microseconds                       rotation_limit;
+            /// Queue messages and format and write them on a background thread instead of the logging thread
+            bool                               async = false;
+            /// Number of messages the async queue holds, rounded up to a power of two. Messages logged while
+            /// it is full are dropped and counted.
+            uint32_t                           queue_size = 8192;
          };
          file_appender( const variant& args );
          ~file_appender();
          virtual void log( const log_message& m )override;
 
+         /// Messages dropped because the async queue was full
+         uint64_t get_dropped_count()const;
+         /// Messages written to the file so far
+         uint64_t get_written_count()const;
+
       private:
          class impl;
          fc::shared_ptr<impl> my;
@@ -31,4 +41,4 @@ class file_appender : public appender {
 
 #include <fc/reflect/reflect.hpp>
 FC_REFLECT( fc::file_appender::config,
-            (format)(filename)(flush)(rotate)(rotation_interval)(rotation_limit) )
+            (format)(filename)(flush)(rotate)(rotation_interval)(rotation_limit)(async)(queue_size) )
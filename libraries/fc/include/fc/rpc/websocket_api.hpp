@@ -28,6 +28,8 @@ namespace fc { namespace rpc {
          std::string on_message(
             const std::string& message,
             bool send_message = true );
+         std::string on_batch( const variants& calls );
+         optional< response > local_call( const request& call );
 
          fc::http::websocket_connection&  _connection;
          fc::rpc::state                   _rpc_state;
@@ -1,8 +1,51 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 /* Common stuff for cryptographic hashes
  */
 namespace fc { namespace detail {
     void shift_l( const char* in, char* out, std::size_t n, unsigned int i);
     void shift_r( const char* in, char* out, std::size_t n, unsigned int i);
+
+    /**
+     *  Hash context that collects short writes before passing them to OpenSSL. fc::raw::pack feeds an encoder
+     *  one field at a time, often only a few bytes, and each Update call has a fixed cost that outweighs the
+     *  compression of such small pieces.
+     */
+    template< typename Context, int (*Update)( Context*, const void*, std::size_t ) >
+    struct buffered_context
+    {
+       static const uint32_t buffer_size = 128;
+
+       Context  ctx;
+       uint32_t pending = 0;
+       char     buffer[ buffer_size ];
+
+       void write( const char* d, uint32_t dlen )
+       {
+          if( pending + dlen > buffer_size )
+          {
+             flush();
+             if( dlen >= buffer_size )
+             {
+                Update( &ctx, d, dlen );
+                return;
+             }
+          }
+          memcpy( buffer + pending, d, dlen );
+          pending += dlen;
+       }
+
+       void flush()
+       {
+          if( pending )
+          {
+             Update( &ctx, buffer, pending );
+             pending = 0;
+          }
+       }
+    };
 }}
@@ -26,12 +26,11 @@ ripemd160::operator string()const { return  str(); }
 char* ripemd160::data()const { return (char*)&_hash[0]; }
 
 
-struct ripemd160::encoder::impl {
+struct ripemd160::encoder::impl : detail::buffered_context< RIPEMD160_CTX, RIPEMD160_Update > {
    impl()
    {
         memset( (char*)&ctx, 0, sizeof(ctx) );
    }
-   RIPEMD160_CTX ctx;
 };
 
 ripemd160::encoder::~encoder() {}
@@ -57,15 +56,17 @@ ripemd160 ripemd160::hash( const string& s ) {
 }
 
 void ripemd160::encoder::write( const char* d, uint32_t dlen ) {
-  RIPEMD160_Update( &my->ctx, d, dlen); 
+  my->write( d, dlen );
 }
 ripemd160 ripemd160::encoder::result() {
   ripemd160 h;
+  my->flush();
   RIPEMD160_Final((uint8_t*)h.data(), &my->ctx );
   return h;
 }
 void ripemd160::encoder::reset() {
   RIPEMD160_Init( &my->ctx);  
+  my->pending = 0;
 }
 
 ripemd160 operator << ( const ripemd160& h1, uint32_t i ) {
@@ -22,9 +22,7 @@ namespace fc {
     char* sha224::data()const { return (char*)&_hash[0]; }
 
 
-    struct sha224::encoder::impl {
-       SHA256_CTX ctx;
-    };
+    struct sha224::encoder::impl : detail::buffered_context< SHA256_CTX, SHA224_Update > {};
 
     sha224::encoder::~encoder() {}
     sha224::encoder::encoder() {
@@ -41,15 +39,17 @@ namespace fc {
     }
 
     void sha224::encoder::write( const char* d, uint32_t dlen ) {
-      SHA224_Update( &my->ctx, d, dlen); 
+      my->write( d, dlen );
     }
     sha224 sha224::encoder::result() {
       sha224 h;
+      my->flush();
       SHA224_Final((uint8_t*)h.data(), &my->ctx );
       return h;
     }
     void sha224::encoder::reset() {
       SHA224_Init( &my->ctx);  
+      my->pending = 0;
     }
 
     sha224 operator << ( const sha224& h1, uint32_t i ) {
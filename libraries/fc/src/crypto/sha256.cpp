@@ -29,9 +29,7 @@ namespace fc {
     char* sha256::data()const { return (char*)&_hash[0]; }
 
 
-    struct sha256::encoder::impl {
-       SHA256_CTX ctx;
-    };
+    struct sha256::encoder::impl : detail::buffered_context< SHA256_CTX, SHA256_Update > {};
 
     sha256::encoder::~encoder() {}
     sha256::encoder::encoder() {
@@ -53,16 +51,27 @@ namespace fc {
         return hash( s.data(), sizeof( s._hash ) );
     }
 
+    void sha256::hash_batch( const char* data, uint32_t message_size, size_t count, sha256* out ) {
+      SHA256_CTX ctx;
+      for( size_t i = 0; i < count; ++i, data += message_size ) {
+        SHA256_Init( &ctx );
+        SHA256_Update( &ctx, data, message_size );
+        SHA256_Final( (uint8_t*)out[i].data(), &ctx );
+      }
+    }
+
     void sha256::encoder::write( const char* d, uint32_t dlen ) {
-      SHA256_Update( &my->ctx, d, dlen); 
+      my->write( d, dlen );
     }
     sha256 sha256::encoder::result() {
       sha256 h;
+      my->flush();
       SHA256_Final((uint8_t*)h.data(), &my->ctx );
       return h;
     }
     void sha256::encoder::reset() {
       SHA256_Init( &my->ctx);  
+      my->pending = 0;
     }
 
     sha256 operator << ( const sha256& h1, uint32_t i ) {
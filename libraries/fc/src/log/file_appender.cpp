@@ -5,8 +5,12 @@
 #include <fc/thread/scoped_lock.hpp>
 #include <fc/thread/thread.hpp>
 #include <fc/variant.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <atomic>
 #include <iomanip>
+#include <memory>
 #include <queue>
 #include <sstream>
 
@@ -19,7 +23,33 @@ namespace fc {
          ofstream                   out;
          boost::mutex               slock;
 
+         std::atomic< uint64_t >    dropped{ 0 };
+         std::atomic< uint64_t >    written{ 0 };
+
       private:
+         /**
+          *  Bounded multi producer, single consumer ring of log messages. A producer claims a position with a CAS on
+          *  _enqueue_pos and publishes the slot by bumping its sequence, the writer thread is the only consumer.
+          *  log_message has reference semantics so a slot holds a pointer copy, not the formatted text.
+          */
+         struct slot
+         {
+            std::atomic< uint64_t >    sequence;
+            log_message                message;
+         };
+
+         std::unique_ptr< slot[] >  _ring;
+         uint64_t                   _mask = 0;
+         std::atomic< uint64_t >    _enqueue_pos{ 0 };
+         uint64_t                   _dequeue_pos = 0;
+
+         boost::thread              _writer;
+         boost::mutex               _wake_lock;
+         boost::condition_variable  _wake;
+         std::atomic< bool >        _writer_sleeping{ false };
+         std::atomic< bool >        _stopping{ false };
+         uint64_t                   _reported_dropped = 0;
+
          future<void>               _rotation_task;
          time_point_sec             _current_file_start_time;
 
@@ -43,10 +73,34 @@ namespace fc {
 
                  _rotation_task = async( [this]() { rotate_files( true ); }, "rotate_files(1)" );
              }
+
+             if( cfg.async )
+             {
+                 uint64_t size = 2;
+                 while( size < cfg.queue_size )
+                    size <<= 1;
+
+                 _ring.reset( new slot[ size ] );
+                 for( uint64_t i = 0; i < size; ++i )
+                    _ring[i].sequence.store( i, std::memory_order_relaxed );
+                 _mask = size - 1;
+
+                 _writer = boost::thread( [this]() { writer_loop(); } );
+             }
          }
 
          ~impl()
          {
+            if( _writer.joinable() )
+            {
+               _stopping = true;
+               {
+                  boost::unique_lock< boost::mutex > lock( _wake_lock );
+                  _wake.notify_one();
+               }
+               _writer.join();
+            }
+
             try
             {
               _rotation_task.cancel_and_wait("file_appender is destructing");
@@ -56,6 +110,131 @@ namespace fc {
             }
          }
 
+         bool is_async()const { return _ring != nullptr; }
+
+         /// Called from any thread, never blocks on the writer
+         void enqueue( const log_message& m )
+         {
+            uint64_t pos = _enqueue_pos.load( std::memory_order_relaxed );
+            slot* s;
+            while( true )
+            {
+               s = &_ring[ pos & _mask ];
+               int64_t diff = int64_t( s->sequence.load( std::memory_order_acquire ) ) - int64_t( pos );
+               if( diff == 0 )
+               {
+                  if( _enqueue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                     break;
+               }
+               else if( diff < 0 )
+               {
+                  dropped.fetch_add( 1, std::memory_order_relaxed );
+                  return;
+               }
+               else
+               {
+                  pos = _enqueue_pos.load( std::memory_order_relaxed );
+               }
+            }
+
+            s->message = m;
+            // Sequentially consistent so it cannot pass the load of _writer_sleeping below
+            s->sequence.store( pos + 1 );
+
+            if( _writer_sleeping.load() )
+            {
+               boost::unique_lock< boost::mutex > lock( _wake_lock );
+               _wake.notify_one();
+            }
+         }
+
+         void writer_loop()
+         {
+            while( true )
+            {
+               bool wrote = false;
+               while( true )
+               {
+                  slot& s = _ring[ _dequeue_pos & _mask ];
+                  if( s.sequence.load( std::memory_order_acquire ) != _dequeue_pos + 1 )
+                     break;
+
+                  log_message m = std::move( s.message );
+                  s.message = log_message();
+                  s.sequence.store( _dequeue_pos + _mask + 1, std::memory_order_release );
+                  ++_dequeue_pos;
+
+                  write( m, false );
+                  wrote = true;
+               }
+
+               if( wrote )
+               {
+                  uint64_t d = dropped.load( std::memory_order_relaxed );
+                  fc::scoped_lock< boost::mutex > lock( slock );
+                  if( d != _reported_dropped )
+                  {
+                     out << string( time_point::now() ) << " file_appender dropped " << ( d - _reported_dropped )
+                         << " log messages, the queue of " << ( _mask + 1 ) << " was full\n";
+                     _reported_dropped = d;
+                  }
+                  if( cfg.flush )
+                     out.flush();
+                  continue;
+               }
+
+               if( _stopping )
+                  return;
+
+               // Checked again under _wake_lock, a producer that sees _writer_sleeping takes it before notifying
+               boost::unique_lock< boost::mutex > lock( _wake_lock );
+               _writer_sleeping = true;
+               if( _ring[ _dequeue_pos & _mask ].sequence.load() != _dequeue_pos + 1 && !_stopping )
+                  _wake.wait_for( lock, boost::chrono::milliseconds( 100 ) );
+               _writer_sleeping = false;
+            }
+         }
+
+         // MS THREAD METHOD  MESSAGE \t\t\t File:Line
+         void write( const log_message& m, bool flush )
+         {
+            std::stringstream line;
+            //line << (m.get_context().get_timestamp().time_since_epoch().count() % (1000ll*1000ll*60ll*60))/1000 <<"ms ";
+            line << string(m.get_context().get_timestamp()) << " ";
+            line << std::setw( 21 ) << (m.get_context().get_thread_name().substr(0,9) + string(":") + m.get_context().get_task_name()).c_str() << " ";
+
+            string method_name = m.get_context().get_method();
+            // strip all leading scopes...
+            if( method_name.size() )
+            {
+               uint32_t p = 0;
+               for( uint32_t i = 0;i < method_name.size(); ++i )
+               {
+                   if( method_name[i] == ':' ) p = i;
+               }
+
+               if( method_name[p] == ':' )
+                 ++p;
+               line << std::setw( 20 ) << m.get_context().get_method().substr(p,20).c_str() <<" ";
+            }
+
+            line << "] ";
+            fc::string message = fc::format_string( m.get_format(), m.get_data() );
+            line << message.c_str();
+
+            //fc::variant lmsg(m);
+
+            // fc::string fmt_str = fc::format_string( cfg.format, mutable_variant_object(m.get_context())( "message", message)  );
+
+            {
+              fc::scoped_lock<boost::mutex> lock( slock );
+              out << line.str() << "\t\t\t" << m.get_context().get_file() << ":" << m.get_context().get_line_number() << "\n";
+              if( flush )
+                out.flush();
+            }
+            written.fetch_add( 1, std::memory_order_relaxed );
+         }
+
          void rotate_files( bool initializing = false )
          {
              FC_ASSERT( cfg.rotate );
@@ -156,43 +335,17 @@ namespace fc {
 
    file_appender::~file_appender(){}
 
-   // MS THREAD METHOD  MESSAGE \t\t\t File:Line
    void file_appender::log( const log_message& m )
    {
-      std::stringstream line;
-      //line << (m.get_context().get_timestamp().time_since_epoch().count() % (1000ll*1000ll*60ll*60))/1000 <<"ms ";
-      line << string(m.get_context().get_timestamp()) << " ";
-      line << std::setw( 21 ) << (m.get_context().get_thread_name().substr(0,9) + string(":") + m.get_context().get_task_name()).c_str() << " ";
-
-      string method_name = m.get_context().get_method();
-      // strip all leading scopes...
-      if( method_name.size() )
-      {
-         uint32_t p = 0;
-         for( uint32_t i = 0;i < method_name.size(); ++i )
-         {
-             if( method_name[i] == ':' ) p = i;
-         }
-
-         if( method_name[p] == ':' )
-           ++p;
-         line << std::setw( 20 ) << m.get_context().get_method().substr(p,20).c_str() <<" ";
-      }
-
-      line << "] ";
-      fc::string message = fc::format_string( m.get_format(), m.get_data() );
-      line << message.c_str();
-
-      //fc::variant lmsg(m);
-
-      // fc::string fmt_str = fc::format_string( my->cfg.format, mutable_variant_object(m.get_context())( "message", message)  );
-
-      {
-        fc::scoped_lock<boost::mutex> lock( my->slock );
-        my->out << line.str() << "\t\t\t" << m.get_context().get_file() << ":" << m.get_context().get_line_number() << "\n";
-        if( my->cfg.flush )
-          my->out.flush();
-      }
+      // The writer thread only reads fields that are fixed when the message is built, logger::log may still append
+      // to the context string of m after this returns
+      if( my->is_async() )
+         my->enqueue( m );
+      else
+         my->write( m, my->cfg.flush );
    }
 
+   uint64_t file_appender::get_dropped_count()const { return my->dropped.load( std::memory_order_relaxed ); }
+   uint64_t file_appender::get_written_count()const { return my->written.load( std::memory_order_relaxed ); }
+
 } // fc
@@ -3,6 +3,16 @@
 
 namespace fc { namespace rpc {
 
+namespace {
+
+/// Reply to a batch entry that is not a request, its id is unknown so JSON-RPC 2.0 answers it with a null id
+variant invalid_request( const std::string& message )
+{
+   return mutable_variant_object( "id", variant() )( "error", error_object{ -32600, message, optional< variant >() } );
+}
+
+}
+
 websocket_api_connection::~websocket_api_connection()
 {
 }
@@ -89,54 +99,24 @@ std::string websocket_api_connection::on_message(
    try
    {
       auto var = fc::json::from_string(message);
+      if( var.is_array() )
+      {
+         auto reply = on_batch( var.get_array() );
+         if( send_message && reply.size() )
+            _connection.send_message( reply );
+         return reply;
+      }
+
       const auto& var_obj = var.get_object();
       if( var_obj.contains( "method" ) )
       {
-         auto call = var.as<fc::rpc::request>();
-         exception_ptr optexcept;
-         try
-         {
-            try
-            {
-#ifdef LOG_LONG_API
-               auto start = time_point::now();
-#endif
-
-               auto result = _rpc_state.local_call( call.method, call.params );
-
-#ifdef LOG_LONG_API
-               auto end = time_point::now();
-
-               if( end - start > fc::milliseconds( LOG_LONG_API_MAX_MS ) )
-                  elog( "API call execution time limit exceeded. method: ${m} params: ${p} time: ${t}", ("m",call.method)("p",call.params)("t", end - start) );
-               else if( end - start > fc::milliseconds( LOG_LONG_API_WARN_MS ) )
-                  wlog( "API call execution time nearing limit. method: ${m} params: ${p} time: ${t}", ("m",call.method)("p",call.params)("t", end - start) );
-#endif
-
-               if( call.id )
-               {
-                  auto reply = fc::json::to_string( response( *call.id, result ) );
-                  if( send_message )
-                     _connection.send_message( reply );
-                  return reply;
-               }
-            }
-            FC_CAPTURE_AND_RETHROW( (call.method)(call.params) )
-         }
-         catch ( const fc::exception& e )
+         auto reply = local_call( var.as<fc::rpc::request>() );
+         if( reply )
          {
-            if( call.id )
-            {
-               optexcept = e.dynamic_copy_exception();
-            }
-         }
-         if( optexcept ) {
-
-               auto reply = fc::json::to_string( response( *call.id,  error_object{ 1, optexcept->to_detail_string(), fc::variant(*optexcept)}  ) );
-               if( send_message )
-                  _connection.send_message( reply );
-
-               return reply;
+            auto reply_str = fc::json::to_string( *reply );
+            if( send_message )
+               _connection.send_message( reply_str );
+            return reply_str;
          }
       }
       else
@@ -153,4 +133,77 @@ std::string websocket_api_connection::on_message(
    return string();
 }
 
+std::string websocket_api_connection::on_batch( const variants& calls )
+{
+   if( calls.empty() )
+      return fc::json::to_string( invalid_request( "Empty batch" ) );
+
+   // Each call takes the locks it needs itself, lookups that must see the same block go through one call such as
+   // database_api::batch_call
+   variants replies;
+   replies.reserve( calls.size() );
+   for( const auto& call : calls )
+   {
+      fc::rpc::request req;
+      try
+      {
+         req = call.as<fc::rpc::request>();
+      }
+      catch( const fc::exception& e )
+      {
+         replies.push_back( invalid_request( e.to_string() ) );
+         continue;
+      }
+
+      auto reply = local_call( req );
+      if( reply )
+         replies.push_back( fc::variant( *reply ) );
+   }
+
+   // Per JSON-RPC 2.0 a batch made only of notifications gets no reply at all
+   if( replies.empty() )
+      return string();
+   return fc::json::to_string( replies );
+}
+
+optional< response > websocket_api_connection::local_call( const request& call )
+{
+   exception_ptr optexcept;
+   try
+   {
+      try
+      {
+#ifdef LOG_LONG_API
+         auto start = time_point::now();
+#endif
+
+         auto result = _rpc_state.local_call( call.method, call.params );
+
+#ifdef LOG_LONG_API
+         auto end = time_point::now();
+
+         if( end - start > fc::milliseconds( LOG_LONG_API_MAX_MS ) )
+            elog( "API call execution time limit exceeded. method: ${m} params: ${p} time: ${t}", ("m",call.method)("p",call.params)("t", end - start) );
+         else if( end - start > fc::milliseconds( LOG_LONG_API_WARN_MS ) )
+            wlog( "API call execution time nearing limit. method: ${m} params: ${p} time: ${t}", ("m",call.method)("p",call.params)("t", end - start) );
+#endif
+
+         if( call.id )
+            return response( *call.id, result );
+      }
+      FC_CAPTURE_AND_RETHROW( (call.method)(call.params) )
+   }
+   catch ( const fc::exception& e )
+   {
+      if( call.id )
+      {
+         optexcept = e.dynamic_copy_exception();
+      }
+   }
+   if( optexcept )
+      return response( *call.id,  error_object{ 1, optexcept->to_detail_string(), fc::variant(*optexcept)} );
+
+   return optional< response >();
+}
+
 } } // namespace fc::rpc
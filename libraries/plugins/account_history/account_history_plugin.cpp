@@ -66,22 +66,7 @@ struct operation_visitor
    {
          const auto& hist_idx = _db.get_index<account_history_index>().indices().get<by_account>();
          if( !new_obj )
-         {
-            new_obj = &_db.create<operation_object>( [&]( operation_object& obj )
-            {
-               obj.trx_id       = _note.trx_id;
-               obj.block        = _note.block;
-               obj.trx_in_block = _note.trx_in_block;
-               obj.op_in_trx    = _note.op_in_trx;
-               obj.virtual_op   = _note.virtual_op;
-               obj.timestamp    = _db.head_block_time();
-               //fc::raw::pack( obj.serialized_op , _note.op);  //call to 'pack' is ambiguous
-               auto size = fc::raw::pack_size( _note.op );
-               obj.serialized_op.resize( size );
-               fc::datastream< char* > ds( obj.serialized_op.data(), size );
-               fc::raw::pack( ds, _note.op );
-            });
-         }
+            new_obj = &_db.get_or_create_operation_object( _note );
 
          auto hist_itr = hist_idx.lower_bound( boost::make_tuple( item, uint32_t(-1) ) );
          uint32_t sequence = 0;
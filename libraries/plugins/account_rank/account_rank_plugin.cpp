@@ -0,0 +1,136 @@
+#include <futurepia/account_rank/account_rank_plugin.hpp>
+
+#include <futurepia/chain/account_object.hpp>
+#include <futurepia/chain/database.hpp>
+
+#include <fc/thread/scoped_lock.hpp>
+
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+
+namespace futurepia { namespace account_rank {
+
+using namespace futurepia::chain;
+
+namespace detail
+{
+
+class account_rank_plugin_impl
+{
+   public:
+      account_rank_plugin_impl( account_rank_plugin& _plugin ) : _self( _plugin ) {}
+
+      futurepia::chain::database& database()
+      {
+         return _self.database();
+      }
+
+      std::vector< account_rank_entry > get_rank( const std::vector< account_rank_entry >& rank, uint32_t limit );
+      void refresh();
+      void build_rank( std::vector< account_rank_entry >& rank,
+                       const std::vector< const account_object* >& accounts, asset account_object::*balance );
+
+      account_rank_plugin&                _self;
+      uint32_t                            _rank_size = 1000;
+
+      boost::mutex                        _mutex;
+      bool                                _ranked = false;
+      block_id_type                       _ranked_block;
+      std::vector< account_rank_entry >   _pia_rank;
+      std::vector< account_rank_entry >   _snac_rank;
+};
+
+std::vector< account_rank_entry > account_rank_plugin_impl::get_rank( const std::vector< account_rank_entry >& rank, uint32_t limit )
+{
+   auto end = rank.begin() + std::min< size_t >( limit, rank.size() );
+   return std::vector< account_rank_entry >( rank.begin(), end );
+}
+
+void account_rank_plugin_impl::refresh()
+{
+   auto& db = database();
+   if( _ranked && _ranked_block == db.head_block_id() )
+      return;
+
+   const auto& idx = db.get_index< account_index >().indices().get< by_id >();
+   std::vector< const account_object* > accounts;
+   accounts.reserve( idx.size() );
+   for( const auto& a : idx )
+      accounts.push_back( &a );
+
+   build_rank( _pia_rank, accounts, &account_object::balance );
+   build_rank( _snac_rank, accounts, &account_object::snac_balance );
+
+   _ranked = true;
+   _ranked_block = db.head_block_id();
+}
+
+void account_rank_plugin_impl::build_rank( std::vector< account_rank_entry >& rank,
+   const std::vector< const account_object* >& accounts, asset account_object::*balance )
+{
+   std::vector< const account_object* > sorted( accounts );
+   auto k = std::min< size_t >( _rank_size, sorted.size() );
+
+   std::partial_sort( sorted.begin(), sorted.begin() + k, sorted.end(),
+      [balance]( const account_object* l, const account_object* r )
+      {
+         if( l->*balance != r->*balance )
+            return l->*balance > r->*balance;
+         return l->id < r->id;
+      });
+
+   rank.clear();
+   rank.reserve( k );
+   for( size_t i = 0; i < k; ++i )
+      rank.push_back( account_rank_entry{ sorted[i]->name, sorted[i]->*balance } );
+}
+
+} // detail
+
+account_rank_plugin::account_rank_plugin( futurepia::app::application* app )
+   : plugin( app ), my( new detail::account_rank_plugin_impl( *this ) ) {}
+
+account_rank_plugin::~account_rank_plugin() {}
+
+void account_rank_plugin::plugin_set_program_options(
+   boost::program_options::options_description& cli,
+   boost::program_options::options_description& cfg
+   )
+{
+   cfg.add_options()
+      ("account-rank-size", boost::program_options::value< uint32_t >()->default_value( 1000 ), "Number of accounts kept in the PIA and SNAC rankings")
+      ;
+}
+
+void account_rank_plugin::plugin_initialize( const boost::program_options::variables_map& options )
+{
+   try
+   {
+      ilog( "Initializing account_rank plugin" );
+
+      if( options.count( "account-rank-size" ) )
+         my->_rank_size = options[ "account-rank-size" ].as< uint32_t >();
+   }
+   FC_CAPTURE_AND_RETHROW()
+}
+
+void account_rank_plugin::plugin_startup() {}
+
+std::vector< account_rank_entry > account_rank_plugin::get_pia_rank( uint32_t limit )
+{
+   fc::scoped_lock< boost::mutex > lock( my->_mutex );
+   my->refresh();
+   return my->get_rank( my->_pia_rank, limit );
+}
+
+std::vector< account_rank_entry > account_rank_plugin::get_snac_rank( uint32_t limit )
+{
+   fc::scoped_lock< boost::mutex > lock( my->_mutex );
+   my->refresh();
+   return my->get_rank( my->_snac_rank, limit );
+}
+
+} } // futurepia::account_rank
+
+FUTUREPIA_DEFINE_PLUGIN( account_rank, futurepia::account_rank::account_rank_plugin )
@@ -0,0 +1,48 @@
+#pragma once
+#include <futurepia/app/plugin.hpp>
+#include <futurepia/chain/database.hpp>
+
+namespace futurepia { namespace account_rank {
+
+#define ACCOUNT_RANK_PLUGIN_NAME "account_rank"
+
+using futurepia::protocol::account_name_type;
+using futurepia::protocol::asset;
+
+namespace detail { class account_rank_plugin_impl; }
+
+struct account_rank_entry
+{
+   account_name_type account;
+   asset             balance;
+};
+
+/**
+ *  Keeps the PIA and SNAC balance rankings outside of the consensus account index.
+ *
+ *  The rankings are top-K snapshots rebuilt lazily, at most once per head block, on the first query after the
+ *  block was applied. Accounts with the same balance are ranked in the order of registration.
+ */
+class account_rank_plugin : public futurepia::app::plugin
+{
+   public:
+      account_rank_plugin( futurepia::app::application* app );
+      virtual ~account_rank_plugin();
+
+      std::string plugin_name()const override { return ACCOUNT_RANK_PLUGIN_NAME; }
+      virtual void plugin_set_program_options(
+         boost::program_options::options_description& cli,
+         boost::program_options::options_description& cfg ) override;
+      virtual void plugin_initialize( const boost::program_options::variables_map& options ) override;
+      virtual void plugin_startup() override;
+
+      /// Requires the read lock. Returns at most account-rank-size entries.
+      std::vector< account_rank_entry > get_pia_rank( uint32_t limit );
+      /// Requires the read lock. Returns at most account-rank-size entries.
+      std::vector< account_rank_entry > get_snac_rank( uint32_t limit );
+
+      friend class detail::account_rank_plugin_impl;
+      std::unique_ptr< detail::account_rank_plugin_impl > my;
+};
+
+} } // futurepia::account_rank
@@ -6,6 +6,7 @@
 #include <futurepia/plugins/block_info/block_info_api.hpp>
 #include <futurepia/plugins/block_info/block_info_plugin.hpp>
 
+#include <algorithm>
 #include <string>
 
 namespace futurepia { namespace plugin { namespace block_info {
@@ -22,16 +23,19 @@ void block_info_plugin::plugin_initialize( const boost::program_options::variabl
 {
    chain::database& db = database();
 
+   _block_info.open( app().data_dir() / "blockchain" / "block_info" );
    _applied_block_conn  = db.applied_block.connect([this](const chain::signed_block& b){ on_applied_block(b); });
 }
 
 void block_info_plugin::plugin_startup()
 {
+   store_head_block_info();
    app().register_api_factory< block_info_api >( "block_info_api" );
 }
 
 void block_info_plugin::plugin_shutdown()
 {
+   _block_info.close();
 }
 
 void block_info_plugin::on_applied_block( const chain::signed_block& b )
@@ -39,19 +43,91 @@ void block_info_plugin::on_applied_block( const chain::signed_block& b )
    uint32_t block_num = b.block_num();
    const chain::database& db = database();
 
-   while( block_num >= _block_info.size() )
-      _block_info.emplace_back();
-
-   block_info& info = _block_info[block_num];
+   block_info info;
    const chain::dynamic_global_property_object& dgpo = db.get_dynamic_global_properties();
 
-   info.block_id                    = b.id();
+   info.block_id                    = dgpo.head_block_id;
    info.block_size                  = fc::raw::pack_size( b );
    info.aslot                       = dgpo.current_aslot;
    info.last_irreversible_block_num = dgpo.last_irreversible_block_num;
+
+   std::lock_guard< std::mutex > guard( _write_mutex );
+   _block_info.set( block_num, info );
    return;
 }
 
+void block_info_plugin::store_head_block_info()
+{
+   chain::database& db = database();
+
+   db.with_write_lock( [&]()
+   {
+      uint32_t head = db.head_block_num();
+      if( head == 0 )
+         return;
+
+      const block_info* stored = _block_info.get( head );
+      if( stored != nullptr && stored->block_size != 0 )
+      {
+         // Drop records left past the head, they belong to blocks this node no longer has
+         if( _block_info.end() > head + 1 )
+         {
+            block_info info = *stored;
+            _block_info.set( head, info );
+         }
+         return;
+      }
+
+      auto b = db.fetch_block_by_number( head );
+      FC_ASSERT( b.valid(), "Head block ${n} is missing from the block log", ("n", head) );
+
+      const chain::dynamic_global_property_object& dgpo = db.get_dynamic_global_properties();
+      block_info info;
+      info.block_id                    = dgpo.head_block_id;
+      info.block_size                  = fc::raw::pack_size( *b );
+      info.aslot                       = dgpo.current_aslot;
+      info.last_irreversible_block_num = dgpo.last_irreversible_block_num;
+      _block_info.set( head, info );
+
+      ilog( "Block info is missing below block ${b}, it is read from the block log when requested", ("b", head) );
+   });
+}
+
+std::vector< block_info > block_info_plugin::read_block_info( uint32_t start, uint32_t end )
+{
+   const chain::database& db = database();
+
+   // Each slot advances aslot by one, so the aslot of any block follows from its time to the head block. The
+   // irreversible block number at the time a block was applied is not in the block log and is left at 0.
+   const chain::dynamic_global_property_object& dgpo = db.get_dynamic_global_properties();
+
+   // Held while copying too, so no reader sees a record that another request is filling in
+   std::lock_guard< std::mutex > guard( _write_mutex );
+
+   end = std::min( end, _block_info.end() );
+   if( start >= end )
+      return std::vector< block_info >();
+
+   const block_info* records = _block_info.get( start );
+   for( uint32_t block_num = start; block_num < end; ++block_num )
+   {
+      if( records[ block_num - start ].block_size != 0 )
+         continue;
+
+      auto b = db.fetch_block_by_number( block_num );
+      if( !b.valid() )
+         continue;
+
+      block_info info;
+      info.block_id   = b->id();
+      info.block_size = fc::raw::pack_size( *b );
+      info.aslot      = dgpo.current_aslot - ( dgpo.time - b->timestamp ).to_seconds() / FUTUREPIA_BLOCK_INTERVAL;
+      _block_info.fill( block_num, info );
+   }
+
+   return std::vector< block_info >( records, records + ( end - start ) );
+}
+
 } } } // futurepia::plugin::block_info
 
 FUTUREPIA_DEFINE_PLUGIN( block_info, futurepia::plugin::block_info::block_info_plugin )
@@ -0,0 +1,131 @@
+#include <futurepia/plugins/block_info/block_info_store.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/io/fstream.hpp>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace futurepia { namespace plugin { namespace block_info {
+
+namespace {
+   const uint32_t block_info_store_magic = 0x46494249; // "IBIF"
+   const uint64_t block_info_store_initial_size = 1024 * 1024; // records
+}
+
+static_assert( std::is_trivially_copyable< block_info >::value, "block_info is stored as raw bytes" );
+
+block_info_store::block_info_store() {}
+
+block_info_store::~block_info_store()
+{
+   close();
+}
+
+void block_info_store::open( const fc::path& file )
+{ try {
+   close();
+   _file = file;
+
+   if( !fc::exists( _file.parent_path() ) )
+      fc::create_directories( _file.parent_path() );
+
+   bool valid = false;
+   if( fc::exists( _file ) )
+   {
+      uint64_t size = fc::file_size( _file );
+      if( size >= sizeof( block_info ) && size % sizeof( block_info ) == 0 )
+      {
+         map( size / sizeof( block_info ) );
+         valid = header().magic == block_info_store_magic && header().record_size == sizeof( block_info )
+              && header().end <= _capacity;
+         if( !valid )
+            close();
+      }
+   }
+
+   if( !valid )
+   {
+      if( fc::exists( _file ) )
+         wlog( "Discarding block info file ${f} with an unknown layout", ("f", _file) );
+
+      // Resizing an empty file zero fills it, which marks every record as not written
+      fc::ofstream( _file ).close();
+      fc::resize_file( _file, block_info_store_initial_size * sizeof( block_info ) );
+      map( block_info_store_initial_size );
+      header() = file_header();
+      header().magic = block_info_store_magic;
+      header().record_size = sizeof( block_info );
+   }
+} FC_CAPTURE_AND_RETHROW( (file) ) }
+
+void block_info_store::close()
+{
+   flush();
+   _base = nullptr;
+   _regions.clear();
+   _mapping.reset();
+   _capacity = 0;
+}
+
+uint32_t block_info_store::end()const
+{
+   return header().end;
+}
+
+const block_info* block_info_store::get( uint32_t start )const
+{
+   if( start == 0 || start >= header().end )
+      return nullptr;
+   return records() + start;
+}
+
+void block_info_store::set( uint32_t block_num, const block_info& info )
+{
+   FC_ASSERT( block_num > 0 );
+
+   if( block_num >= _capacity )
+   {
+      // The old mapping stays in place for readers still holding pointers into it
+      uint64_t capacity = std::max< uint64_t >( block_num + 1, _capacity * 2 );
+      fc::resize_file( _file, capacity * sizeof( block_info ) );
+      map( capacity );
+   }
+
+   records()[ block_num ] = info;
+   header().end = block_num + 1;
+}
+
+void block_info_store::fill( uint32_t block_num, const block_info& info )
+{
+   FC_ASSERT( block_num > 0 && block_num < header().end );
+   records()[ block_num ] = info;
+}
+
+void block_info_store::flush()
+{
+   if( !_regions.empty() )
+      _regions.back()->flush();
+}
+
+void block_info_store::map( uint64_t records )
+{
+   if( !_mapping )
+      _mapping.reset( new fc::file_mapping( _file.generic_string().c_str(), fc::read_write ) );
+   _regions.emplace_back( new fc::mapped_region( *_mapping, fc::read_write ) );
+   _base = static_cast< char* >( _regions.back()->get_address() );
+   _capacity = records;
+}
+
+block_info_store::file_header& block_info_store::header()const
+{
+   static_assert( sizeof( file_header ) <= sizeof( block_info ), "the header lives in the slot of block 0" );
+   return *reinterpret_cast< file_header* >( _base.load() );
+}
+
+block_info* block_info_store::records()const
+{
+   return reinterpret_cast< block_info* >( _base.load() );
+}
+
+} } } // futurepia::plugin::block_info
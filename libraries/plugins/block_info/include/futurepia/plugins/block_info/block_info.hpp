@@ -2,6 +2,7 @@
 #pragma once
 
 #include <futurepia/chain/futurepia_object_types.hpp>
+#include <futurepia/protocol/block.hpp>
 
 namespace futurepia { namespace plugin { namespace block_info {
 
@@ -15,7 +16,7 @@ struct block_info
 
 struct block_with_info
 {
-   chain::signed_block       block;
+   protocol::signed_block    block;
    block_info                info;
 };
 
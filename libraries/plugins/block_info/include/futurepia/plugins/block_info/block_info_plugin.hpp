@@ -3,7 +3,9 @@
 
 #include <futurepia/app/plugin.hpp>
 #include <futurepia/plugins/block_info/block_info.hpp>
+#include <futurepia/plugins/block_info/block_info_store.hpp>
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -28,7 +30,21 @@ class block_info_plugin : public futurepia::app::plugin
 
       void on_applied_block( const chain::signed_block& b );
 
-      std::vector< block_info > _block_info;
+      /**
+       *  Returns the records of blocks in [ start, end ), cut at the last stored block. Records that were never
+       *  stored are filled in first from the block log. Called by the API under the database read lock.
+       */
+      std::vector< block_info > read_block_info( uint32_t start, uint32_t end );
+
+      /// Written and copied out under _write_mutex
+      block_info_store _block_info;
+
+   private:
+      /// Stores the head block if it has no record, the blocks below it are filled in on demand
+      void store_head_block_info();
+
+      /// Serializes on_applied_block with read_block_info, which writes missing records before copying them
+      std::mutex _write_mutex;
 
       boost::signals2::scoped_connection _applied_block_conn;
 };
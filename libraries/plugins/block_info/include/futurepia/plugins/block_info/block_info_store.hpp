@@ -0,0 +1,67 @@
+#pragma once
+
+#include <futurepia/plugins/block_info/block_info.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/interprocess/file_mapping.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace futurepia { namespace plugin { namespace block_info {
+
+/**
+ *  Keeps one fixed size block_info record per block in a memory mapped file, the record of block n is at offset
+ *  n * sizeof( block_info ). Block numbers start at 1, so the slot of block 0 holds the file header.
+ *
+ *  A record with a block_size of 0 has not been written. The file doubles in size as blocks are added. Readers may
+ *  still run while set() grows it, so earlier mappings are kept until close() and the pointers returned by get()
+ *  stay valid until then.
+ */
+class block_info_store
+{
+   public:
+      block_info_store();
+      ~block_info_store();
+
+      /// Opens file, creating it or starting over when it is missing or was written with a different layout
+      void open( const fc::path& file );
+      void close();
+      bool is_open()const { return _base != nullptr; }
+
+      /// One past the highest block number stored
+      uint32_t end()const;
+
+      /// Records of blocks [ start, end() ), nullptr when start is not below end()
+      const block_info* get( uint32_t start )const;
+
+      /// Stores the record of block_num and makes it the last stored block
+      void set( uint32_t block_num, const block_info& info );
+
+      /// Stores the record of a block below end() that has not been written, without moving end()
+      void fill( uint32_t block_num, const block_info& info );
+
+      void flush();
+
+   private:
+      struct file_header
+      {
+         uint32_t magic = 0;
+         uint32_t record_size = 0;
+         uint32_t end = 0;
+      };
+
+      void map( uint64_t records );
+      file_header& header()const;
+      block_info* records()const;
+
+      fc::path                                              _file;
+      std::unique_ptr< fc::file_mapping >                   _mapping;
+      /// Every mapping made since open(), the last one covers the whole file
+      std::vector< std::unique_ptr< fc::mapped_region > >   _regions;
+      std::atomic< char* >                                  _base{ nullptr };
+      uint64_t                                              _capacity = 0;
+};
+
+} } } // futurepia::plugin::block_info
@@ -19,6 +19,7 @@ namespace futurepia { namespace dapp {
             optional< dapp_discussion > get_dapp_content( string dapp_name, string author, string permlink ) const;
             vector< dapp_discussion > get_dapp_content_replies( string dapp_name, string author, string permlink )const;
             vector< dapp_discussion > lookup_dapp_contents( string dapp_name, string last_author, string last_permlink, uint32_t limit )const;
+            futurepia::app::paged_result< dapp_discussion > lookup_dapp_contents_paged( string dapp_name, string cursor, uint32_t limit )const;
 
             vector< dapp_discussion > get_dapp_discussions_by_author_before_date( 
                      string dapp_name, string author, string start_permlink, time_point_sec before_date, uint32_t limit )const;
@@ -244,6 +245,54 @@ namespace futurepia { namespace dapp {
          FC_CAPTURE_AND_RETHROW( ( dapp_name )( last_author )( last_permlink )( limit ) )
       }
 
+      futurepia::app::paged_result< dapp_discussion > dapp_api_impl::lookup_dapp_contents_paged( string dapp_name, string cursor, uint32_t limit )const
+      {
+         try
+         {
+            auto& db = *(_app.chain_database());
+            FC_ASSERT( limit > 0 && limit <= 100 );
+
+            const auto& created_idx = db.get_index< dapp_comment_index >().indices().get< by_dapp_and_created >();
+            auto key_of = []( const dapp_comment_object& c )
+            {
+               return fc::variants{ fc::variant( c.dapp_name ), fc::variant( c.created ), fc::variant( c.id._id ) };
+            };
+
+            auto created_itr = created_idx.lower_bound( boost::make_tuple( dapp_name, time_point_sec::maximum() ) );
+            if( cursor.size() > 0 )
+            {
+               created_itr = futurepia::app::seek_cursor< dapp_comment_object >( db, created_idx,
+                  futurepia::app::decode_cursor( cursor, "dapp_contents.by_dapp_and_created" ), key_of,
+                  [&]( const fc::variants& key )
+                  {
+                     return created_idx.upper_bound( boost::make_tuple( key.at( 0 ).as< dapp_name_type >(),
+                        key.at( 1 ).as< time_point_sec >(), dapp_comment_id_type( key.at( 2 ).as_int64() ) ) );
+                  });
+            }
+
+            dapp_discussion_query q;
+            q.dapp_name = dapp_name;
+            q.limit = limit;
+            q.truncate_body = 1024;
+
+            futurepia::app::paged_result< dapp_discussion > result;
+            result.items = get_dapp_discussions( q, created_idx, created_itr
+               , []( const dapp_comment_api_obj& c ){ return c.parent_author.size() > 0; }
+               , exit_default
+               , true );
+
+            if( result.items.size() == limit )
+            {
+               const auto& last = db.get< dapp_comment_object >( result.items.back().id );
+               result.next_cursor = futurepia::app::encode_cursor(
+                  futurepia::app::api_cursor{ "dapp_contents.by_dapp_and_created", uint64_t( last.id._id ), key_of( last ) } );
+            }
+
+            return result;
+         }
+         FC_CAPTURE_AND_RETHROW( ( dapp_name )( cursor )( limit ) )
+      }
+
       vector< dapp_discussion >  dapp_api_impl::get_dapp_discussions_by_author_before_date( string dapp_name, string author, string start_permlink, time_point_sec before_date, uint32_t limit )const
       {
          try
@@ -505,6 +554,14 @@ namespace futurepia { namespace dapp {
       });
    }
 
+   futurepia::app::paged_result< dapp_discussion > dapp_api::lookup_dapp_contents_paged( string dapp_name, string cursor, uint32_t limit )const
+   {
+      return _my->database().with_read_lock( [ & ]()
+      {
+         return _my->lookup_dapp_contents_paged( dapp_name, cursor, limit );
+      });
+   }
+
    vector< dapp_comment_vote_api_object > dapp_api::get_dapp_active_votes( string dapp_name, string author, string permlink, comment_vote_type type ) const
    {
       return _my->database().with_read_lock( [ & ]()
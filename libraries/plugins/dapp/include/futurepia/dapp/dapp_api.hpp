@@ -1,4 +1,5 @@
 #pragma once
+#include <futurepia/app/api_cursor.hpp>
 #include <futurepia/app/application.hpp>
 #include <futurepia/dapp/dapp_objects.hpp>
 
@@ -308,6 +309,16 @@ namespace futurepia { namespace dapp {
           * */
          vector< dapp_discussion > lookup_dapp_contents( string dapp_name, string last_author, string last_permlink, uint32_t limit )const;
 
+         /**
+          * same as lookup_dapp_contents, paged with an opaque cursor.
+          * @param dapp_name dapp name.
+          * @param cursor next_cursor of the previous page, empty string for the first page.
+          * @param limit max count of searched contnents.
+          *        This should be greater than 0, and equal 100 or less than.
+          * @return contents of dapp and the cursor of the next page.
+          * */
+         futurepia::app::paged_result< dapp_discussion > lookup_dapp_contents_paged( string dapp_name, string cursor, uint32_t limit )const;
+
          /**
           * get list of user of a dapp.
           * @param dapp_name dapp name.
@@ -428,6 +439,7 @@ FC_API( futurepia::dapp::dapp_api,
    ( get_dapp_active_votes )
    ( get_dapp_account_votes )
    ( lookup_dapp_contents )
+   ( lookup_dapp_contents_paged )
    ( lookup_dapp_users )
    ( get_join_dapps )
    ( get_dapp_votes )
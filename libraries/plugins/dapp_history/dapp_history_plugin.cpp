@@ -37,38 +37,9 @@ namespace futurepia { namespace dapp_history {
 
          template<typename Op>
          void operator()( Op&& )const {
-            if( !_new_obj ) {
-               const auto& idx = _db.get_index< operation_index >().indices().get< by_location >();
-               auto itr = idx.lower_bound( boost::make_tuple( _note.block, _note.trx_in_block, _note.op_in_trx, _note.virtual_op ) );
-               if( itr != idx.end() && itr->block == _note.block 
-                  && itr->trx_in_block == _note.trx_in_block && itr->op_in_trx == _note.op_in_trx
-                  && itr->virtual_op == _note.virtual_op ) {
-                  _new_obj = &( *itr );
-               } else {
-                  while( itr != idx.end() && itr->block == _note.block ){
-                     if(itr->trx_in_block == _note.trx_in_block && itr->op_in_trx == _note.op_in_trx && itr->virtual_op == _note.virtual_op) {
-                        _new_obj = &( *itr );
-                        break;
-                     }
-                     itr++;
-                  }
-               }
-
-               if( !_new_obj ) {
-                  _new_obj = &_db.create< operation_object >( [&]( operation_object& object ) {
-                     object.trx_id       = _note.trx_id;
-                     object.block        = _note.block;
-                     object.trx_in_block = _note.trx_in_block;
-                     object.op_in_trx    = _note.op_in_trx;
-                     object.virtual_op   = _note.virtual_op;
-                     object.timestamp    = _db.head_block_time();
-                     auto size = fc::raw::pack_size( _note.op );
-                     object.serialized_op.resize( size );
-                     fc::datastream< char* > ds( object.serialized_op.data(), size );
-                     fc::raw::pack( ds, _note.op );
-                  });
-               }
-            }
+            // Shared with account_history through the notification, whichever plugin runs first creates it
+            if( !_new_obj )
+               _new_obj = &_db.get_or_create_operation_object( _note );
 
             const auto& hist_idx = _db.get_index< dapp_history_index >().indices().get< by_dapp_name >();
             auto hist_itr = hist_idx.lower_bound( boost::make_tuple( dapp_name, uint32_t(-1) ) );
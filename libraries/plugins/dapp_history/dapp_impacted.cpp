@@ -27,6 +27,7 @@
 #include <futurepia/chain/custom_operation_interpreter.hpp>
 #include <futurepia/chain/generic_custom_operation_interpreter.hpp>
 
+#include <futurepia/dapp/dapp_plugin.hpp>
 #include <futurepia/dapp_history/dapp_impacted.hpp>
 
 #include <fc/utility.hpp>
@@ -279,10 +280,11 @@ namespace futurepia { namespace dapp_history {
    }
 
    void get_imapcted_dapp_from_custom( const custom_binary_operation& op, chain::database& db, flat_set< dapp_name_type >& result ) {
-      process_inner_operation< dapp_operation >( op.data, get_dapp_name_visitor_from_custom( db, result ) );
-      process_inner_operation< token_operation >( op.data, get_dapp_name_visitor_from_custom( db, result ) );
-      process_inner_operation< private_message_plugin_operation >( op.data, get_dapp_name_visitor_from_custom( db, result ) );
-      process_inner_operation< bobserver_plugin_operation >( op.data, get_dapp_name_visitor_from_custom( db, result ) );
+      // Packed data carries no type names, only the plugin named by id is tried
+      if( op.id == DAPP_PLUGIN_NAME )
+         process_inner_operation< dapp_operation >( op.data, get_dapp_name_visitor_from_custom( db, result ) );
+      else if( op.id == TOKEN_PLUGIN_NAME )
+         process_inner_operation< token_operation >( op.data, get_dapp_name_visitor_from_custom( db, result ) );
    }
 
    void operation_get_impacted_dapp( const operation& op, chain::database& db, flat_set< dapp_name_type >& result ) {
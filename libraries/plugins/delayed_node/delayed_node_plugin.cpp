@@ -35,6 +35,7 @@
 #include <fc/api.hpp>
 #include <fc/smart_ref_impl.hpp>
 
+#include <map>
 
 namespace futurepia { namespace delayed_node {
 namespace bpo = boost::program_options;
@@ -48,6 +49,7 @@ struct delayed_node_plugin_impl {
    boost::signals2::scoped_connection client_connection_closed;
    futurepia::chain::block_id_type last_received_remote_head;
    futurepia::chain::block_id_type last_processed_remote_head;
+   uint32_t fetch_window = 32;
 };
 }
 
@@ -62,6 +64,7 @@ void delayed_node_plugin::plugin_set_program_options(bpo::options_description& c
 {
    cli.add_options()
          ("trusted-node", boost::program_options::value<std::string>(), "RPC endpoint of a trusted validating node (required)")
+         ("delayed-node-fetch-window", boost::program_options::value<uint32_t>()->default_value(32), "Number of get_block requests kept outstanding to the trusted node while catching up")
          ;
    cfg.add(cli);
 }
@@ -79,6 +82,7 @@ void delayed_node_plugin::plugin_initialize(const boost::program_options::variab
 {
    FC_ASSERT( options.count( "trusted-node" ) > 0 );
    my->remote_endpoint = "ws://" + options.at("trusted-node").as<std::string>();
+   my->fetch_window = std::max< uint32_t >( options.at("delayed-node-fetch-window").as<uint32_t>(), 1 );
 }
 
 void delayed_node_plugin::sync_with_trusted_node()
@@ -102,12 +106,31 @@ void delayed_node_plugin::sync_with_trusted_node()
          break;
       }
       pass_count++;
+
+      // Keep up to fetch_window requests in flight so catching up is not bound by the round trip time. Replies may
+      // complete in any order, they are pushed in block number order as the lowest outstanding one arrives.
+      std::map< uint32_t, fc::future< futurepia::chain::signed_block > > pending;
+      uint32_t next_request = db.head_block_num() + 1;
       while( remote_dpo.last_irreversible_block_num > db.head_block_num() )
       {
-         fc::optional<futurepia::chain::signed_block> block = my->database_api->get_block( db.head_block_num()+1 );
-         FC_ASSERT(block, "Trusted node claims it has blocks it doesn't actually have.");
-         ilog("Pushing block #${n}", ("n", block->block_num()));
-         db.push_block(*block);
+         while( next_request <= remote_dpo.last_irreversible_block_num && pending.size() < my->fetch_window )
+         {
+            uint32_t block_num = next_request++;
+            pending[ block_num ] = fc::async( [this, block_num]() -> futurepia::chain::signed_block
+            {
+               fc::optional<futurepia::chain::signed_block> block = my->database_api->get_block( block_num );
+               FC_ASSERT(block, "Trusted node claims it has blocks it doesn't actually have.");
+               return *block;
+            }, "delayed_node_fetch" );
+         }
+
+         auto itr = pending.begin();
+         FC_ASSERT( itr->first == db.head_block_num() + 1, "Delayed node head moved while fetching blocks" );
+         futurepia::chain::signed_block block = itr->second.wait();
+         pending.erase( itr );
+
+         ilog("Pushing block #${n}", ("n", block.block_num()));
+         db.push_block(block);
          synced_blocks++;
       }
    }
@@ -28,6 +28,12 @@ struct get_raw_block_result
    std::string                   raw_block;
 };
 
+struct get_raw_blocks_args
+{
+   uint32_t start_block_num = 0;
+   uint32_t count = 0;
+};
+
 class raw_block_api
 {
    public:
@@ -36,6 +42,12 @@ class raw_block_api
       void on_api_startup();
 
       get_raw_block_result get_raw_block( get_raw_block_args args );
+
+      /**
+       * Returns up to count consecutive blocks starting at start_block_num, ending early at the head block or once
+       * the response grows past a few megabytes. Older blocks are copied from the block log without being unpacked.
+       */
+      std::vector< get_raw_block_result > get_raw_blocks( get_raw_blocks_args args );
       void push_raw_block( std::string block_b64 );
 
    private:
@@ -55,7 +67,13 @@ FC_REFLECT( futurepia::plugin::raw_block::get_raw_block_result,
    (raw_block)
    )
 
+FC_REFLECT( futurepia::plugin::raw_block::get_raw_blocks_args,
+   (start_block_num)
+   (count)
+   )
+
 FC_API( futurepia::plugin::raw_block::raw_block_api,
    (get_raw_block)
+   (get_raw_blocks)
    (push_raw_block)
    )
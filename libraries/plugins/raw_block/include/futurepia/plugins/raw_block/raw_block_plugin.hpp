@@ -2,6 +2,14 @@
 #pragma once
 
 #include <futurepia/app/plugin.hpp>
+#include <futurepia/plugins/raw_block/raw_block_api.hpp>
+
+#include <deque>
+#include <string>
+
+namespace futurepia { namespace protocol {
+struct signed_block;
+} }
 
 namespace futurepia { namespace plugin { namespace raw_block {
 
@@ -14,9 +22,28 @@ class raw_block_plugin : public futurepia::app::plugin
       virtual ~raw_block_plugin();
 
       virtual std::string plugin_name()const override;
+      virtual void plugin_set_program_options(
+         boost::program_options::options_description& cli,
+         boost::program_options::options_description& cfg ) override;
       virtual void plugin_initialize( const boost::program_options::variables_map& options ) override;
       virtual void plugin_startup() override;
       virtual void plugin_shutdown() override;
+
+      void on_applied_block( const chain::signed_block& b );
+
+      /// Block number of the first cached block, 0 when the cache is empty
+      uint32_t first_cached_block_num()const;
+
+      /**
+       * The serialized form of the most recent blocks of the current chain, in block number order, so that clients
+       * following the head do not have each block packed and encoded again for every request.
+       * Written under the database write lock, read under its read lock.
+       */
+      std::deque< get_raw_block_result > _recent_blocks;
+
+   private:
+      uint32_t                           _cache_size = 0;
+      boost::signals2::scoped_connection _applied_block_conn;
 };
 
 } } }
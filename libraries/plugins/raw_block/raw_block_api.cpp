@@ -2,6 +2,8 @@
 #include <futurepia/app/api_context.hpp>
 #include <futurepia/app/application.hpp>
 
+#include <futurepia/chain/database.hpp>
+
 #include <futurepia/plugins/raw_block/raw_block_api.hpp>
 #include <futurepia/plugins/raw_block/raw_block_plugin.hpp>
 
@@ -16,6 +18,8 @@ class raw_block_api_impl
 
       std::shared_ptr< futurepia::plugin::raw_block::raw_block_plugin > get_plugin();
 
+      std::vector< get_raw_block_result > get_raw_blocks( uint32_t start_block_num, uint32_t count );
+
       futurepia::app::application& app;
 };
 
@@ -27,6 +31,68 @@ std::shared_ptr< futurepia::plugin::raw_block::raw_block_plugin > raw_block_api_
    return app.get_plugin< raw_block_plugin >( "raw_block" );
 }
 
+namespace {
+   const uint32_t max_raw_blocks_count = 1000;
+   const uint64_t max_raw_blocks_bytes = 8 * 1024 * 1024;
+}
+
+std::vector< get_raw_block_result > raw_block_api_impl::get_raw_blocks( uint32_t start_block_num, uint32_t count )
+{
+   std::vector< get_raw_block_result > result;
+   std::shared_ptr< futurepia::chain::database > db = app.chain_database();
+   std::shared_ptr< raw_block_plugin > plugin = get_plugin();
+
+   db->with_read_lock( [&]()
+   {
+      uint32_t first_cached = plugin->first_cached_block_num();
+      uint64_t bytes = 0;
+
+      if( first_cached == 0 || start_block_num < first_cached )
+      {
+         uint32_t uncached = first_cached == 0 ? count : std::min( count, first_cached - start_block_num );
+         std::vector< std::vector< char > > blocks = db->fetch_raw_blocks( start_block_num, uncached, max_raw_blocks_bytes );
+
+         result.reserve( blocks.size() );
+         for( const auto& packed : blocks )
+         {
+            // The header is the start of the packed block, so it is all that needs to be unpacked
+            fc::datastream< const char* > ds( packed.data(), packed.size() );
+            chain::signed_block_header header;
+            fc::raw::unpack( ds, header );
+
+            get_raw_block_result r;
+            r.block_id = header.id();
+            r.previous = header.previous;
+            r.timestamp = header.timestamp;
+            r.raw_block = fc::base64_encode( packed.data(), packed.size() );
+            result.push_back( std::move( r ) );
+
+            bytes += packed.size();
+         }
+
+         if( blocks.size() < uncached )
+            return;
+      }
+
+      if( first_cached == 0 )
+         return;
+
+      // Blocks popped without a replacement being applied yet stay cached past the head until one is
+      uint32_t head = db->head_block_num();
+      size_t cached = head < first_cached ? 0 : std::min< size_t >( plugin->_recent_blocks.size(), head + 1 - first_cached );
+      for( size_t i = start_block_num + result.size() - first_cached; i < cached && result.size() < count; ++i )
+      {
+         // base64 takes 4 bytes for every 3
+         bytes += plugin->_recent_blocks[ i ].raw_block.size() / 4 * 3;
+         if( bytes > max_raw_blocks_bytes && !result.empty() )
+            break;
+         result.push_back( plugin->_recent_blocks[ i ] );
+      }
+   });
+
+   return result;
+}
+
 } // detail
 
 raw_block_api::raw_block_api( const futurepia::app::api_context& ctx )
@@ -36,21 +102,16 @@ raw_block_api::raw_block_api( const futurepia::app::api_context& ctx )
 
 get_raw_block_result raw_block_api::get_raw_block( get_raw_block_args args )
 {
-   get_raw_block_result result;
-   std::shared_ptr< futurepia::chain::database > db = my->app.chain_database();
+   std::vector< get_raw_block_result > blocks = my->get_raw_blocks( args.block_num, 1 );
+   if( blocks.empty() )
+      return get_raw_block_result();
+   return std::move( blocks.front() );
+}
 
-   fc::optional<chain::signed_block> block = db->fetch_block_by_number( args.block_num );
-   if( !block.valid() )
-   {
-      return result;
-   }
-   std::vector<char> serialized_block = fc::raw::pack( *block );
-   result.raw_block = fc::base64_encode( std::string(
-      &serialized_block[0], &serialized_block[0] + serialized_block.size()) );
-   result.block_id = block->id();
-   result.previous = block->previous;
-   result.timestamp = block->timestamp;
-   return result;
+std::vector< get_raw_block_result > raw_block_api::get_raw_blocks( get_raw_blocks_args args )
+{
+   FC_ASSERT( args.count <= detail::max_raw_blocks_count, "count cannot be greater than ${m}", ("m", detail::max_raw_blocks_count) );
+   return my->get_raw_blocks( args.start_block_num, args.count );
 }
 
 void raw_block_api::push_raw_block( std::string block_b64 )
@@ -1,8 +1,13 @@
 
+#include <futurepia/chain/database.hpp>
+#include <futurepia/chain/global_property_object.hpp>
 
 #include <futurepia/plugins/raw_block/raw_block_api.hpp>
 #include <futurepia/plugins/raw_block/raw_block_plugin.hpp>
 
+#include <fc/crypto/base64.hpp>
+#include <fc/io/raw.hpp>
+
 #include <string>
 
 namespace futurepia { namespace plugin { namespace raw_block {
@@ -15,8 +20,24 @@ std::string raw_block_plugin::plugin_name()const
    return "raw_block";
 }
 
+void raw_block_plugin::plugin_set_program_options(
+   boost::program_options::options_description& cli,
+   boost::program_options::options_description& cfg
+   )
+{
+   cli.add_options()
+         ("raw-block-cache-size", boost::program_options::value< uint32_t >()->default_value( 1200 ), "Number of the most recent blocks kept serialized for the raw block API, 0 disables the cache")
+         ;
+   cfg.add( cli );
+}
+
 void raw_block_plugin::plugin_initialize( const boost::program_options::variables_map& options )
 {
+   if( options.count( "raw-block-cache-size" ) )
+      _cache_size = options.at( "raw-block-cache-size" ).as< uint32_t >();
+
+   if( _cache_size > 0 )
+      _applied_block_conn = database().applied_block.connect( [this]( const chain::signed_block& b ){ on_applied_block( b ); } );
 }
 
 void raw_block_plugin::plugin_startup()
@@ -28,6 +49,39 @@ void raw_block_plugin::plugin_shutdown()
 {
 }
 
+void raw_block_plugin::on_applied_block( const chain::signed_block& b )
+{
+   uint32_t block_num = b.block_num();
+
+   // A block applied again after a fork switch, or after a gap, replaces everything from its number on
+   while( !_recent_blocks.empty() && first_cached_block_num() + _recent_blocks.size() > block_num )
+      _recent_blocks.pop_back();
+   if( !_recent_blocks.empty() && first_cached_block_num() + _recent_blocks.size() != block_num )
+      _recent_blocks.clear();
+
+   // Blocks of a reindex, replay or sync would be pushed out of the cache long before anyone asks for them
+   if( b.timestamp + _cache_size * FUTUREPIA_BLOCK_INTERVAL < fc::time_point::now() )
+      return;
+
+   std::vector< char > packed = fc::raw::pack( b );
+
+   get_raw_block_result entry;
+   // The block was hashed once when it was pushed, the head block id is that hash
+   entry.block_id = database().get_dynamic_global_properties().head_block_id;
+   entry.previous = b.previous;
+   entry.timestamp = b.timestamp;
+   entry.raw_block = fc::base64_encode( packed.data(), packed.size() );
+   _recent_blocks.push_back( std::move( entry ) );
+
+   while( _recent_blocks.size() > _cache_size )
+      _recent_blocks.pop_front();
+}
+
+uint32_t raw_block_plugin::first_cached_block_num()const
+{
+   return _recent_blocks.empty() ? 0 : chain::block_header::num_from_id( _recent_blocks.front().block_id );
+}
+
 } } } // futurepia::plugin::raw_block
 
 FUTUREPIA_DEFINE_PLUGIN( raw_block, futurepia::plugin::raw_block::raw_block_plugin )
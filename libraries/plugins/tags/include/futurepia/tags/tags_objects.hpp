@@ -46,13 +46,11 @@ class tag_object : public object< tag_object_type, tag_object >
 typedef oid< tag_object > tag_id_type;
 
 /**
- *  The purpose of the tag object is to allow the generation and listing of
- *  all top level posts by a string tag.  The desired sort orders include:
+ *  Links a comment to one of the tags in its json_metadata. Tag names are interned in tag_object, so every
+ *  comment_tag_object only carries the tag id, and by_tag keeps the comments of a tag in the order they were
+ *  tagged, which is the posting list get_discussions_by_tag walks.
  *
- *  1. created - time of creation
- *  2. active - last reply the post or any child of the post
- *
- *  When ever a comment is modified, all tag_objects for that comment are updated to match.
+ *  Entries are only written when the tags of a comment change. Votes and replies do not touch them.
  */
 class comment_tag_object : public object< comment_tag_type, comment_tag_object >
 {
@@ -71,8 +69,6 @@ class comment_tag_object : public object< comment_tag_type, comment_tag_object >
       tag_id_type       tag;
 
       time_point_sec    created;
-      time_point_sec    active;
-      int32_t           children    = 0;
       account_id_type   author;
       comment_id_type   parent;
 };
@@ -112,10 +108,6 @@ typedef multi_index_container <
    allocator< tag_object >
 > tag_index;
 
-struct by_parent_created;
-struct by_parent_active;
-struct by_parent_children; /// all top level posts with the most discussion (replies at all levels)
-struct by_author_parent_created;  /// all blog posts by author with tag
 struct by_author_comment;
 struct by_comment;
 struct by_tag;
@@ -155,62 +147,6 @@ typedef multi_index_container<
                std::less< comment_id_type >, 
                std::less< comment_tag_id_type > 
             >
-      >,
-      ordered_unique< tag< by_parent_created >,
-            composite_key< comment_tag_object,
-               member< comment_tag_object, tag_id_type, &comment_tag_object::tag >,
-               member< comment_tag_object, comment_id_type, &comment_tag_object::parent >,
-               member< comment_tag_object, time_point_sec, &comment_tag_object::created >,
-               member< comment_tag_object, comment_tag_id_type, &comment_tag_object::id >
-            >,
-            composite_key_compare< 
-               std::less< tag_id_type >, 
-               std::less< comment_id_type >, 
-               std::greater< time_point_sec >, 
-               std::less< comment_tag_id_type > 
-            >
-      >,
-      ordered_unique< tag< by_parent_active >,
-            composite_key< comment_tag_object,
-               member< comment_tag_object, tag_id_type, &comment_tag_object::tag >,
-               member< comment_tag_object, comment_id_type, &comment_tag_object::parent >,
-               member< comment_tag_object, time_point_sec, &comment_tag_object::active >,
-               member< comment_tag_object, comment_tag_id_type, &comment_tag_object::id >
-            >,
-            composite_key_compare< 
-               std::less< tag_id_type >, 
-               std::less< comment_id_type >, 
-               std::greater< time_point_sec >, 
-               std::less< comment_tag_id_type > 
-            >
-      >,
-      ordered_unique< tag< by_parent_children >,
-            composite_key< comment_tag_object,
-               member< comment_tag_object, tag_id_type, &comment_tag_object::tag >,
-               member< comment_tag_object, comment_id_type, &comment_tag_object::parent >,
-               member< comment_tag_object, int32_t, &comment_tag_object::children >,
-               member< comment_tag_object, comment_tag_id_type, &comment_tag_object::id >
-            >,
-            composite_key_compare< 
-               std::less< tag_id_type >, 
-               std::less< comment_id_type >, 
-               std::greater< int32_t >, 
-               std::less< comment_tag_id_type > 
-            >
-      >,
-      ordered_unique< tag< by_author_parent_created >,
-            composite_key< comment_tag_object,
-               member< comment_tag_object, tag_id_type, &comment_tag_object::tag >,
-               member< comment_tag_object, account_id_type, &comment_tag_object::author >,
-               member< comment_tag_object, time_point_sec, &comment_tag_object::created >,
-               member< comment_tag_object, comment_tag_id_type, &comment_tag_object::id >
-            >,
-            composite_key_compare< 
-               std::less< tag_id_type >, 
-               std::less< account_id_type >, 
-               std::greater< time_point_sec >, 
-               std::less< comment_tag_id_type > 
-            >
       >
    >,
    allocator< comment_tag_object >
@@ -236,8 +172,6 @@ FC_REFLECT( futurepia::tags::comment_tag_object,
    ( id )
    ( tag )
    ( created )
-   ( active )
-   ( children )
    ( author )
    ( parent )
    ( comment ) 
@@ -111,14 +111,6 @@ struct operation_visitor
       return meta;
    }
 
-   void update_comment_tag( const comment_tag_object& current, const comment_object& comment )const
-   {
-      _db.modify( current, [&]( comment_tag_object& obj ) {
-         obj.active            = comment.active;
-         obj.children          = comment.children;
-      });
-   }
-
    void create_comment_tag( const string& tag, const comment_object& comment )const
    {
       comment_id_type parent;
@@ -157,81 +149,52 @@ struct operation_visitor
           obj.comment           = comment.id;
           obj.parent            = parent;
           obj.created           = comment.created;
-          obj.active            = comment.active;
-          obj.children          = comment.children;
           obj.author            = author;
       });
    }
 
-   /** finds tags that have been added or removed or updated */
-   void update_tags( const comment_object& c, bool parse_tags = false )const
+   /** finds tags that have been added or removed */
+   void update_tags( const comment_object& c )const
    {
-      dlog( "update_tags : author = ${author}, permlink = ${permlink}, parse_tags=${parse_tags}"
-         , ( "author", c.author )( "permlink", c.permlink )( "parse_tags", parse_tags ) );
+      dlog( "update_tags : author = ${author}, permlink = ${permlink}", ( "author", c.author )( "permlink", c.permlink ) );
       try {
          const auto& comment_idx = _db.get_index< comment_tag_index >().indices().get< by_comment >();
          const auto& tag_idx = _db.get_index< tag_index >().indices().get< by_id >();
 
-         if( parse_tags )
-         {
-            auto meta = filter_tags( c );
-            auto citr = comment_idx.lower_bound( c.id );
-
-            map< string, const comment_tag_object* > existing_tags;
-            vector< const comment_tag_object* > remove_queue;
-
-            while( citr != comment_idx.end() && citr->comment == c.id )
-            {
-               const comment_tag_object* tag = &*citr;
-               ++citr;
-               const auto tag_itr = tag_idx.find( tag->tag );
-
-               if( meta.tags.find( tag_itr->tag ) == meta.tags.end() )
-                  remove_queue.push_back( tag );
-               else
-                  existing_tags[ tag_itr->tag ] = tag;
-            }
-
-            for( const auto& tag : meta.tags )
-            {
-               auto existing = existing_tags.find( tag );
-
-               dlog( "tag = ${tag}, existing = ${existing}", ( "tag", tag )( "existing", existing != existing_tags.end() ) ); 
-
-               if( existing == existing_tags.end() )
-               {
-                  create_comment_tag( tag, c );
-               }
-               else
-               {
-                  update_comment_tag( *existing->second, c );
-               }
-            }
-
-            for( const auto& item : remove_queue )
-               remove_comment_tag(*item);
-         }
-         else
-         {
-            auto citr = comment_idx.lower_bound( c.id );
+         auto meta = filter_tags( c );
+         auto citr = comment_idx.lower_bound( c.id );
+
+         set< string > existing_tags;
+         vector< const comment_tag_object* > remove_queue;
 
-            while( citr != comment_idx.end() && citr->comment == c.id )
-            {
-               update_comment_tag( *citr, c );
-               ++citr;
-            }
+         while( citr != comment_idx.end() && citr->comment == c.id )
+         {
+            const comment_tag_object* tag = &*citr;
+            ++citr;
+            const auto tag_itr = tag_idx.find( tag->tag );
+
+            if( meta.tags.find( tag_itr->tag ) == meta.tags.end() )
+               remove_queue.push_back( tag );
+            else
+               existing_tags.insert( tag_itr->tag );
          }
 
-         if( c.parent_author.size() )
+         for( const auto& tag : meta.tags )
          {
-            update_tags( _db.get_comment( c.parent_author, c.parent_permlink ) );
+            if( existing_tags.find( tag ) == existing_tags.end() )
+               create_comment_tag( tag, c );
          }
+
+         for( const auto& item : remove_queue )
+            remove_comment_tag(*item);
       } FC_CAPTURE_LOG_AND_RETHROW( (c) )
    }
 
    void operator()( const comment_operation& op )const
    {
-      update_tags( _db.get_comment( op.author, op.permlink ), true );
+      // json_metadata is only replaced when the operation carries one, otherwise the tags did not change
+      if( op.json_metadata.size() )
+         update_tags( _db.get_comment( op.author, op.permlink ) );
    }
 
    void operator()( const delete_comment_operation& op )const
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <futurepia/app/api_cursor.hpp>
 #include <futurepia/app/application.hpp>
 #include <futurepia/app/futurepia_api_objects.hpp>
 
@@ -196,6 +197,16 @@ namespace futurepia { namespace token {
           * */
          vector< token_fund_withdraw_api_obj > lookup_token_fund_withdraw ( string token, string fund, string account, int req_id, uint32_t limit) const;
 
+         /**
+          * same as lookup_token_fund_withdraw, paged with an opaque cursor
+          * @param token token name
+          * @param fund fund name
+          * @param cursor next_cursor of the previous page, empty string("") for the first page.
+          * @param limit max count of withdraw list getting at once. limit is 1000 or less.
+          * @return fund withdraw list of a token and the cursor of the next page
+          * */
+         futurepia::app::paged_result< token_fund_withdraw_api_obj > lookup_token_fund_withdraw_paged( string token, string fund, string cursor, uint32_t limit ) const;
+
          /**
           * get token fund details
           * @param token token name
@@ -238,6 +249,15 @@ namespace futurepia { namespace token {
           * */
          vector< token_savings_withdraw_api_obj > lookup_token_savings_withdraw( string token, string from, string to, int req_id, int limit ) const;
 
+         /**
+          * same as lookup_token_savings_withdraw, paged with an opaque cursor
+          * @param token token name
+          * @param cursor next_cursor of the previous page, empty string("") for the first page.
+          * @param limit max count of withdraw list getting at once. limit is 1000 or less.
+          * @return saving withdraw list of a token and the cursor of the next page
+          * */
+         futurepia::app::paged_result< token_savings_withdraw_api_obj > lookup_token_savings_withdraw_paged( string token, string cursor, uint32_t limit ) const;
+
       private:
          std::shared_ptr< detail::token_api_impl > _my;
    };
@@ -311,9 +331,11 @@ FC_API( futurepia::token::token_api,
    ( get_tokens_by_dapp )
    ( get_token_staking_list )
    ( lookup_token_fund_withdraw )
+   ( lookup_token_fund_withdraw_paged )
    ( get_token_fund )
    ( get_token_staking_interest )
    ( get_token_savings_withdraw_from )
    ( get_token_savings_withdraw_to )
    ( lookup_token_savings_withdraw )
+   ( lookup_token_savings_withdraw_paged )
 )
\ No newline at end of file
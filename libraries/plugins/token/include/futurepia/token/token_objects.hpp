@@ -7,6 +7,9 @@
 #include <futurepia/dapp/dapp_objects.hpp>
 
 #include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <boost/functional/hash.hpp>
 
 
 namespace futurepia { namespace token {
@@ -159,8 +162,20 @@ namespace futurepia { namespace token {
    struct by_name;
    struct by_symbol;
    struct by_account_and_token;
+   struct by_account_and_token_hash;
    struct by_token;
    struct by_dapp_name;
+
+   struct account_name_hash
+   {
+      size_t operator()( const account_name_type& name )const
+      {
+         size_t seed = 0;
+         boost::hash_combine( seed, name.data.hi );
+         boost::hash_combine( seed, name.data.lo );
+         return seed;
+      }
+   };
    
    typedef multi_index_container <
       token_object,
@@ -201,6 +216,15 @@ namespace futurepia { namespace token {
                member < token_balance_object, token_name_type, & token_balance_object::token >
             >
          >,
+         hashed_unique <
+            tag< by_account_and_token_hash >,
+            composite_key <
+               token_balance_object,
+               member < token_balance_object, account_name_type, & token_balance_object::account >,
+               member < token_balance_object, token_name_type, & token_balance_object::token >
+            >,
+            composite_key_hash < account_name_hash, account_name_hash >
+         >,
          ordered_non_unique <
             tag< by_token >,
             member < token_balance_object, token_name_type, & token_balance_object::token >
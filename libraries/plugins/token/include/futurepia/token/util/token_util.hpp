@@ -26,94 +26,65 @@ namespace futurepia { namespace token { namespace util {
          } FC_CAPTURE_AND_RETHROW( ( token )( fund )( delta )( withdraw_delta ) )
       }
 
-      void adjust_token_balance( const account_name_type& account, const token_name_type& token, const asset& delta ) {
-         try {
-            auto now = _db.head_block_time();
-            const auto& balance_idx = _db.get_index< token_balance_index >().indices().get< by_account_and_token >();
-            auto balance_itr = balance_idx.find( boost::make_tuple( account, token ) );
-
-            FC_ASSERT( _db.find_account( account ) != nullptr, "No accounts" );
-            
-            if( delta.amount < 0 ) {
-               FC_ASSERT(balance_itr != balance_idx.end(), "${account} account doesn't have ${token} token balance."
-                  , ( "token", token )( "account", account ) );
-
-               FC_ASSERT( balance_itr->balance.symbol == delta.symbol, "invalid symbol" );
-
-               if( balance_itr->savings_balance.amount == 0 && balance_itr->balance == -delta ){
-                  _db.remove( *balance_itr );
-               } else {
-                  FC_ASSERT( balance_itr->balance >= -delta, "Balances lack" );
+      /// Hashed lookup, nullptr if the account never held the token
+      const token_balance_object* find_token_balance( const account_name_type& account, const token_name_type& token )const {
+         const auto& balance_idx = _db.get_index< token_balance_index >().indices().get< by_account_and_token_hash >();
+         auto balance_itr = balance_idx.find( boost::make_tuple( account, token ) );
+         return balance_itr == balance_idx.end() ? nullptr : &*balance_itr;
+      }
 
-                  _db.modify( *balance_itr, [&]( token_balance_object &obj ) {
-                     obj.balance += delta;
-                     obj.last_updated = now;
-                  });
-               }
-            } else {
-               if(balance_itr == balance_idx.end()) {
-                  _db.create< token_balance_object >( [&]( token_balance_object& obj ) {
-                     obj.account = account;
-                     obj.token = token;
-                     obj.balance = delta;
-                     obj.savings_balance = asset(0, delta.symbol);
-                     obj.last_updated = now;
-                  });
-               } else {
-                  FC_ASSERT( balance_itr->balance.symbol == delta.symbol, "invalid symbol" );
-                  
-                  _db.modify( *balance_itr, [&]( token_balance_object &obj ) {
-                     obj.balance += delta;
-                     obj.last_updated = now;
-                  });
-               }
-            }
-         } FC_CAPTURE_AND_RETHROW( ( account )( token )( delta ) )
+      void adjust_token_balance( const account_name_type& account, const token_name_type& token, const asset& delta ) {
+         adjust_token_balances( account, token, delta, asset( 0, delta.symbol ) );
       }
 
       void adjust_token_savings_balance( const account_name_type& account, const token_name_type& token, const asset& delta ) {
+         adjust_token_balances( account, token, asset( 0, delta.symbol ), delta );
+      }
+
+      /**
+       * Applies both deltas to the balance object of account with a single lookup. The object is removed when a
+       * withdrawal leaves both balances empty.
+       */
+      void adjust_token_balances( const account_name_type& account, const token_name_type& token, const asset& delta, const asset& savings_delta ) {
          try {
+            FC_ASSERT( delta.symbol == savings_delta.symbol, "invalid symbol" );
+
             auto now = _db.head_block_time();
-            const auto& balance_idx = _db.get_index< token_balance_index >().indices().get< by_account_and_token >();
-            auto balance_itr = balance_idx.find( boost::make_tuple( account, token ) );
+            const token_balance_object* balance = find_token_balance( account, token );
 
-            FC_ASSERT( _db.find_account( account ) != nullptr, "No accounts" );
-            
-            if( delta.amount < 0 ) {
-               FC_ASSERT(balance_itr != balance_idx.end(), "${account} account doesn't have ${token} token savings balance."
+            if( balance == nullptr ) {
+               FC_ASSERT( delta.amount >= 0, "${account} account doesn't have ${token} token balance."
                   , ( "token", token )( "account", account ) );
+               FC_ASSERT( savings_delta.amount >= 0, "${account} account doesn't have ${token} token savings balance."
+                  , ( "token", token )( "account", account ) );
+               // An existing balance object implies the account exists, only new ones need the check
+               FC_ASSERT( _db.find_account( account ) != nullptr, "No accounts" );
+
+               _db.create< token_balance_object >( [&]( token_balance_object& obj ) {
+                  obj.account = account;
+                  obj.token = token;
+                  obj.balance = delta;
+                  obj.savings_balance = savings_delta;
+                  obj.last_updated = now;
+               });
+               return;
+            }
 
-               FC_ASSERT( balance_itr->savings_balance.symbol == delta.symbol, "invalid symbol" );
-
-               if( balance_itr->balance.amount == 0 && balance_itr->savings_balance == -delta ){
-                  _db.remove( *balance_itr );
-               } else {
-                  FC_ASSERT( balance_itr->savings_balance >= -delta, "Savings balances lack" );
+            FC_ASSERT( balance->balance.symbol == delta.symbol, "invalid symbol" );
+            FC_ASSERT( delta.amount >= 0 || balance->balance >= -delta, "Balances lack" );
+            FC_ASSERT( savings_delta.amount >= 0 || balance->savings_balance >= -savings_delta, "Savings balances lack" );
 
-                  _db.modify( *balance_itr, [&]( token_balance_object &obj ) {
-                     obj.savings_balance += delta;
-                     obj.last_updated = now;
-                  });
-               }
+            if( ( delta.amount < 0 || savings_delta.amount < 0 )
+               && ( balance->balance + delta ).amount == 0 && ( balance->savings_balance + savings_delta ).amount == 0 ) {
+               _db.remove( *balance );
             } else {
-               if(balance_itr == balance_idx.end()) {
-                  _db.create< token_balance_object >( [&]( token_balance_object& obj ) {
-                     obj.account = account;
-                     obj.token = token;
-                     obj.balance = asset(0, delta.symbol);
-                     obj.savings_balance = delta;
-                     obj.last_updated = now;
-                  });
-               } else {
-                  FC_ASSERT( balance_itr->savings_balance.symbol == delta.symbol, "invalid symbol" );
-                  
-                  _db.modify( *balance_itr, [&]( token_balance_object &obj ) {
-                     obj.savings_balance += delta;
-                     obj.last_updated = now;
-                  });
-               }
+               _db.modify( *balance, [&]( token_balance_object &obj ) {
+                  obj.balance += delta;
+                  obj.savings_balance += savings_delta;
+                  obj.last_updated = now;
+               });
             }
-         } FC_CAPTURE_AND_RETHROW( ( account )( token )( delta ) )
+         } FC_CAPTURE_AND_RETHROW( ( account )( token )( delta )( savings_delta ) )
       }
 
    private:
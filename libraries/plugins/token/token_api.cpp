@@ -22,6 +22,8 @@ namespace futurepia { namespace token {
             vector< token_savings_withdraw_api_obj > get_token_savings_withdraw_from( string token, string from ) const;
             vector< token_savings_withdraw_api_obj > get_token_savings_withdraw_to( string token, string to ) const;
             vector< token_savings_withdraw_api_obj > lookup_token_savings_withdraw( string token, string from, string to, int req_id, int limit ) const;
+            futurepia::app::paged_result< token_fund_withdraw_api_obj > lookup_token_fund_withdraw_paged( string token, string fund, string cursor, uint32_t limit ) const;
+            futurepia::app::paged_result< token_savings_withdraw_api_obj > lookup_token_savings_withdraw_paged( string token, string cursor, uint32_t limit ) const;
 
             futurepia::chain::database& database() { return *_app.chain_database(); }
 
@@ -175,6 +177,74 @@ namespace futurepia { namespace token {
          return results;
       }
 
+      futurepia::app::paged_result< token_fund_withdraw_api_obj > token_api_impl::lookup_token_fund_withdraw_paged( string token, string fund, string cursor, uint32_t limit ) const {
+         FC_ASSERT(limit <= 1000, "limit should be 1000 or less" );
+
+         auto& db = *_app.chain_database();
+         const auto& withdraw_idx = db.get_index< token_fund_withdraw_index >().indices().get< by_token_fund >();
+         auto key_of = []( const token_fund_withdraw_object& o ) {
+            return fc::variants{ fc::variant( o.token ), fc::variant( o.fund_name ), fc::variant( o.from ), fc::variant( o.request_id ) };
+         };
+
+         auto itr = withdraw_idx.lower_bound( boost::make_tuple( token, fund ) );
+         if( cursor.size() ) {
+            itr = futurepia::app::seek_cursor< token_fund_withdraw_object >( db, withdraw_idx,
+               futurepia::app::decode_cursor( cursor, "token_fund_withdraw.by_token_fund" ), key_of,
+               [&]( const fc::variants& key ) {
+                  return withdraw_idx.upper_bound( boost::make_tuple( key.at( 0 ).as< token_name_type >(), key.at( 1 ).as< fund_name_type >(),
+                     key.at( 2 ).as< account_name_type >(), uint32_t( key.at( 3 ).as_uint64() ) ) );
+               });
+         }
+
+         futurepia::app::paged_result< token_fund_withdraw_api_obj > result;
+         const token_fund_withdraw_object* last = nullptr;
+         while( itr != withdraw_idx.end() && itr->token == token && itr->fund_name == fund && result.items.size() < limit ) {
+            result.items.push_back( *itr );
+            last = &*itr;
+            itr++;
+         }
+
+         if( last != nullptr && itr != withdraw_idx.end() && itr->token == token && itr->fund_name == fund )
+            result.next_cursor = futurepia::app::encode_cursor(
+               futurepia::app::api_cursor{ "token_fund_withdraw.by_token_fund", uint64_t( last->id._id ), key_of( *last ) } );
+
+         return result;
+      }
+
+      futurepia::app::paged_result< token_savings_withdraw_api_obj > token_api_impl::lookup_token_savings_withdraw_paged( string token, string cursor, uint32_t limit ) const {
+         FC_ASSERT(limit <= 1000, "limit should be 1000 or less" );
+
+         auto& db = *_app.chain_database();
+         const auto& idx = db.get_index< token_savings_withdraw_index >().indices().get< by_token_from_to >();
+         auto key_of = []( const token_savings_withdraw_object& o ) {
+            return fc::variants{ fc::variant( o.token ), fc::variant( o.from ), fc::variant( o.to ), fc::variant( o.request_id ) };
+         };
+
+         auto itr = idx.lower_bound( token );
+         if( cursor.size() ) {
+            itr = futurepia::app::seek_cursor< token_savings_withdraw_object >( db, idx,
+               futurepia::app::decode_cursor( cursor, "token_savings_withdraw.by_token_from_to" ), key_of,
+               [&]( const fc::variants& key ) {
+                  return idx.upper_bound( boost::make_tuple( key.at( 0 ).as< token_name_type >(), key.at( 1 ).as< account_name_type >(),
+                     key.at( 2 ).as< account_name_type >(), uint32_t( key.at( 3 ).as_uint64() ) ) );
+               });
+         }
+
+         futurepia::app::paged_result< token_savings_withdraw_api_obj > result;
+         const token_savings_withdraw_object* last = nullptr;
+         while( itr != idx.end() && itr->token == token && result.items.size() < limit ) {
+            result.items.push_back( *itr );
+            last = &*itr;
+            itr++;
+         }
+
+         if( last != nullptr && itr != idx.end() && itr->token == token )
+            result.next_cursor = futurepia::app::encode_cursor(
+               futurepia::app::api_cursor{ "token_savings_withdraw.by_token_from_to", uint64_t( last->id._id ), key_of( *last ) } );
+
+         return result;
+      }
+
    } //namespace details
 
    token_api::token_api( const futurepia::app::api_context& ctx ) {
@@ -255,4 +325,16 @@ namespace futurepia { namespace token {
       });
    }
 
+   futurepia::app::paged_result< token_fund_withdraw_api_obj > token_api::lookup_token_fund_withdraw_paged( string token, string fund, string cursor, uint32_t limit ) const {
+      return _my->database().with_read_lock( [ & ]() {
+         return _my->lookup_token_fund_withdraw_paged( token, fund, cursor, limit );
+      });
+   }
+
+   futurepia::app::paged_result< token_savings_withdraw_api_obj > token_api::lookup_token_savings_withdraw_paged( string token, string cursor, uint32_t limit ) const {
+      return _my->database().with_read_lock( [ & ]() {
+         return _my->lookup_token_savings_withdraw_paged( token, cursor, limit );
+      });
+   }
+
 } } //namespace futurepia::token
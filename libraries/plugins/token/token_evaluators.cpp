@@ -84,7 +84,7 @@ namespace futurepia { namespace token {
             token.last_updated = now;
          });
 
-         const auto& balance_itr = _db.find< token_balance_object, by_account_and_token >( boost::make_tuple( op.publisher, op.name ) );
+         const auto& balance_itr = _db.find< token_balance_object, by_account_and_token_hash >( boost::make_tuple( op.publisher, op.name ) );
          if(balance_itr == nullptr) 
          {
             _db.create< token_balance_object > ( [&]( token_balance_object& token_balance )
@@ -160,7 +160,7 @@ namespace futurepia { namespace token {
             obj.last_updated = now;
          });
 
-         const auto& balance_itr = _db.find< token_balance_object, by_account_and_token >( boost::make_tuple( op.publisher, op.name ) );
+         const auto& balance_itr = _db.find< token_balance_object, by_account_and_token_hash >( boost::make_tuple( op.publisher, op.name ) );
          if(balance_itr == nullptr) 
          {
             _db.create< token_balance_object > ( [&]( token_balance_object& token_balance )
@@ -621,8 +621,7 @@ namespace futurepia { namespace token {
          FC_ASSERT( withdraw_itr != withdraw_idx.end(), "No withdraw information");
 
          util::token_util utils(_db);
-         utils.adjust_token_savings_balance( withdraw_itr->to, op.token, -( withdraw_itr->amount ) );
-         utils.adjust_token_balance( withdraw_itr->to, op.token, withdraw_itr->amount );
+         utils.adjust_token_balances( withdraw_itr->to, op.token, withdraw_itr->amount, -( withdraw_itr->amount ) );
 
          _db.push_virtual_operation( fill_transfer_token_savings_operation( withdraw_itr->from, withdraw_itr->to
                   , withdraw_itr->token, withdraw_itr->request_id, withdraw_itr->amount, withdraw_itr->total_amount
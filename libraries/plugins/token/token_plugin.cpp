@@ -96,8 +96,7 @@ namespace futurepia { namespace token {
                break;
             
             if ( withdraw_itr->split_pay_order == withdraw_itr->split_pay_month ) { // last month
-               utils.adjust_token_savings_balance( withdraw_itr->to, withdraw_itr->token, -( withdraw_itr->amount ) );
-               utils.adjust_token_balance( withdraw_itr->to, withdraw_itr->token, withdraw_itr->amount );
+               utils.adjust_token_balances( withdraw_itr->to, withdraw_itr->token, withdraw_itr->amount, -( withdraw_itr->amount ) );
 
                _db.push_virtual_operation( fill_transfer_token_savings_operation( withdraw_itr->from, withdraw_itr->to
                   , withdraw_itr->token, withdraw_itr->request_id, withdraw_itr->amount, withdraw_itr->total_amount
@@ -108,8 +107,7 @@ namespace futurepia { namespace token {
             } else {  // others
                asset monthly_amount = withdraw_itr->total_amount;
                monthly_amount.amount /= withdraw_itr->split_pay_month;
-               utils.adjust_token_savings_balance( withdraw_itr->to, withdraw_itr->token, -monthly_amount );
-               utils.adjust_token_balance( withdraw_itr->to, withdraw_itr->token, monthly_amount);
+               utils.adjust_token_balances( withdraw_itr->to, withdraw_itr->token, monthly_amount, -monthly_amount );
 
                _db.push_virtual_operation( fill_transfer_token_savings_operation( withdraw_itr->from, withdraw_itr->to, withdraw_itr->token
                   , withdraw_itr->request_id, monthly_amount, withdraw_itr->total_amount
@@ -1,9 +1,12 @@
 #include <futurepia/protocol/block.hpp>
+#include <futurepia/protocol/id_hash_counters.hpp>
 #include <fc/io/raw.hpp>
 #include <fc/bitutil.hpp>
 #include <algorithm>
 
 namespace futurepia { namespace protocol {
+   std::atomic< uint64_t > id_hash_counters::block_ids( 0 );
+
    digest_type block_header::digest()const
    {
       return digest_type::hash(*this);
@@ -16,6 +19,7 @@ namespace futurepia { namespace protocol {
 
    block_id_type signed_block_header::id()const
    {
+      id_hash_counters::block_ids.fetch_add( 1, std::memory_order_relaxed );
       auto tmp = fc::sha224::hash( *this );
       tmp._hash[0] = fc::endian_reverse_u32(block_num()); // store the block num in the ID, 160 bits is plenty for the hash
       static_assert( sizeof(tmp._hash[0]) == 4, "should be 4 bytes" );
@@ -52,12 +56,11 @@ namespace futurepia { namespace protocol {
       vector<digest_type>::size_type current_number_of_hashes = ids.size();
       while( current_number_of_hashes > 1 )
       {
-         // hash ID's in pairs
+         // hash ID's in pairs, a pair packs to the two digests back to back so a whole level is one batch
          uint32_t i_max = current_number_of_hashes - (current_number_of_hashes&1);
-         uint32_t k = 0;
+         uint32_t k = i_max / 2;
 
-         for( uint32_t i = 0; i < i_max; i += 2 )
-            ids[k++] = digest_type::hash( std::make_pair( ids[i], ids[i+1] ) );
+         digest_type::hash_batch( ids[0].data(), 2 * sizeof( digest_type ), k, ids.data() );
 
          if( current_number_of_hashes&1 )
             ids[k++] = ids[i_max];
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <fc/reflect/reflect.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace futurepia { namespace protocol {
+
+/**
+ *  Process wide number of ids hashed by signed_block_header::id() and transaction::id(), to check how often the
+ *  apply pipeline recomputes them.
+ */
+struct id_hash_counters
+{
+   static std::atomic< uint64_t > block_ids;
+   static std::atomic< uint64_t > transaction_ids;
+};
+
+struct id_hash_stats
+{
+   uint64_t block_ids = 0;
+   uint64_t transaction_ids = 0;
+};
+
+} } // futurepia::protocol
+
+FC_REFLECT( futurepia::protocol::id_hash_stats, (block_ids)(transaction_ids) )
@@ -176,6 +176,13 @@ namespace fc
     void from_variant( const fc::variant& var, futurepia::protocol::extended_public_key_type& vo );
     void to_variant( const futurepia::protocol::extended_private_key_type& var, fc::variant& vo );
     void from_variant( const fc::variant& var, futurepia::protocol::extended_private_key_type& vo );
+
+    namespace raw
+    {
+       // public_key_type packs as its key_data and holds nothing else
+       template<> struct is_memcpy_packable< futurepia::protocol::public_key_type > : std::true_type {};
+       static_assert( sizeof( futurepia::protocol::public_key_type ) == sizeof( fc::ecc::public_key_data ), "public_key_type must only hold key_data" );
+    }
 }
 
 FC_REFLECT( futurepia::protocol::public_key_type, (key_data) )
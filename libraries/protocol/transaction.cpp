@@ -1,6 +1,7 @@
 
 #include <futurepia/protocol/transaction.hpp>
 #include <futurepia/protocol/exceptions.hpp>
+#include <futurepia/protocol/id_hash_counters.hpp>
 
 #include <fc/io/raw.hpp>
 #include <fc/bitutil.hpp>
@@ -39,8 +40,11 @@ void transaction::validate() const
       operation_validate(op);
 }
 
+std::atomic< uint64_t > futurepia::protocol::id_hash_counters::transaction_ids( 0 );
+
 futurepia::protocol::transaction_id_type futurepia::protocol::transaction::id() const
 {
+   id_hash_counters::transaction_ids.fetch_add( 1, std::memory_order_relaxed );
    auto h = digest();
    transaction_id_type result;
    memcpy(result._hash, h._hash, std::min(sizeof(result), sizeof(h)));
@@ -706,6 +706,12 @@ class wallet_api
        */
       void set_transaction_expiration(uint32_t seconds);
 
+      /**
+       * Sends token and dapp operations as fc::raw packed custom_binary_operation instead of custom_json_hf2_operation.
+       * Binary operations are smaller and skip JSON parsing on every node.
+       */
+      void use_binary_custom_operations( bool enabled );
+
       /**
        * Create an account recovery request as a recover account. The syntax for this command contains a serialized authority object
        * so there is an example below on how to pass in the authority.
@@ -1345,6 +1351,7 @@ FC_API( futurepia::wallet::wallet_api,
         (create_comment_betting_state)
         (update_comment_betting_state)
         (set_transaction_expiration)
+        (use_binary_custom_operations)
         (request_account_recovery)
         (recover_account)
         (change_recovery_account)
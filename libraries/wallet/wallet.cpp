@@ -505,6 +505,27 @@ public:
       _tx_expiration_seconds = tx_expiration_seconds;
    }
 
+   /**
+    * Returns json_op unchanged, or the plugin operation packed into a custom_binary_operation with the same
+    * id and authorities when binary custom operations are enabled.
+    */
+   template< typename PluginOperationType >
+   operation make_custom_operation( const custom_json_hf2_operation& json_op, const PluginOperationType& plugin_op )const
+   {
+      if( !_binary_custom_operations )
+         return json_op;
+
+      custom_binary_operation binary_op;
+      binary_op.required_owner_auths = json_op.required_owner_auths;
+      binary_op.required_active_auths = json_op.required_active_auths;
+      binary_op.required_posting_auths = json_op.required_posting_auths;
+      binary_op.required_auths = json_op.required_auths;
+      binary_op.id = json_op.id;
+      // Always packed as a vector, a single packed operation can be mistaken for a vector by the interpreter
+      binary_op.data = fc::raw::pack( vector< PluginOperationType >( 1, plugin_op ) );
+      return binary_op;
+   }
+
    annotated_signed_transaction sign_transaction(signed_transaction tx, bool broadcast = false)
    {
       flat_set< account_name_type >   req_active_approvals;
@@ -877,6 +898,7 @@ public:
    optional< fc::api< dapp::dapp_api > >                     _remote_dapp_api;
    optional< fc::api< dapp_history::dapp_history_api > >     _remote_dapp_history_api;
    uint32_t                                                  _tx_expiration_seconds = 30;
+   bool                                                      _binary_custom_operations = false;
 
    flat_map<string, operation>                               _prototype_ops;
 
@@ -2004,6 +2026,11 @@ void wallet_api::set_transaction_expiration(uint32_t seconds)
    my->set_transaction_expiration(seconds);
 }
 
+void wallet_api::use_binary_custom_operations( bool enabled )
+{
+   my->_binary_custom_operations = enabled;
+}
+
 annotated_signed_transaction wallet_api::get_transaction( transaction_id_type id )const {
    return my->_remote_db->get_transaction( id );
 }
@@ -2179,7 +2206,7 @@ annotated_signed_transaction wallet_api::create_token( string dapp_name, string
       custom_op.required_auths.push_back( authority( 1, dapp_info->dapp_key, 1 ) );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2208,7 +2235,7 @@ annotated_signed_transaction wallet_api::issue_token( string token_name, string
       custom_op.required_auths.push_back( authority( 1, dapp_info->dapp_key, 1 ) );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2263,7 +2290,7 @@ annotated_signed_transaction wallet_api::transfer_token( string from, string to,
       custom_op.required_active_auths.insert( from );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2288,7 +2315,7 @@ annotated_signed_transaction wallet_api::burn_token( string account, asset amoun
       custom_op.required_active_auths.insert( account );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2331,7 +2358,7 @@ annotated_signed_transaction wallet_api::set_token_staking_interest( string publ
       custom_op.required_active_auths.insert( publisher );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2358,7 +2385,7 @@ annotated_signed_transaction wallet_api::setup_token_fund( string publisher, str
       custom_op.required_active_auths.insert( publisher );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2386,7 +2413,7 @@ annotated_signed_transaction wallet_api::transfer_token_fund( string from, strin
       custom_op.required_active_auths.insert( from );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2416,7 +2443,7 @@ annotated_signed_transaction wallet_api::staking_token_fund( string from, string
       custom_op.required_active_auths.insert( from );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2479,7 +2506,7 @@ annotated_signed_transaction wallet_api::transfer_token_savings( string from, st
       custom_op.required_active_auths.insert( from );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2506,7 +2533,7 @@ annotated_signed_transaction wallet_api::cancel_transfer_token_savings( string t
       custom_op.required_active_auths.insert( from );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2533,7 +2560,7 @@ annotated_signed_transaction wallet_api::conclude_transfer_token_savings( string
       custom_op.required_active_auths.insert( from );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2586,7 +2613,7 @@ creating_dapp_result wallet_api::create_dapp ( string owner, string name, bool b
       custom_operation.required_active_auths.insert( owner );
 
       signed_transaction trx;
-      trx.operations.push_back( custom_operation );
+      trx.operations.push_back( my->make_custom_operation( custom_operation, dapp_op ) );
       trx.validate();
 
       annotated_signed_transaction signed_trx = my->sign_transaction( trx, broadcast );
@@ -2619,7 +2646,7 @@ creating_dapp_result wallet_api::reissue_dapp_key ( string owner, string name, b
       custom_operation.required_active_auths.insert( owner );
 
       signed_transaction trx;
-      trx.operations.push_back( custom_operation );
+      trx.operations.push_back( my->make_custom_operation( custom_operation, dapp_op ) );
       trx.validate();
 
       annotated_signed_transaction signed_trx = my->sign_transaction( trx, broadcast );
@@ -2677,7 +2704,7 @@ annotated_signed_transaction wallet_api::post_dapp_comment( string dapp_name, st
       custom_op.required_posting_auths.insert( author );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2705,7 +2732,7 @@ annotated_signed_transaction wallet_api::vote_dapp_comment( string dapp_name, st
       custom_op.required_posting_auths.insert( voter );
 
       signed_transaction tx;
-      tx.operations.push_back(custom_op);
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction(tx, broadcast);
@@ -2732,7 +2759,7 @@ annotated_signed_transaction wallet_api::delete_dapp_comment( string dapp_name,
       custom_op.required_posting_auths.insert( author );
 
       signed_transaction tx;
-      tx.operations.push_back( custom_op );
+      tx.operations.push_back( my->make_custom_operation( custom_op, plugin_op ) );
       tx.validate();
 
       return my->sign_transaction( tx, broadcast );
@@ -2782,7 +2809,7 @@ annotated_signed_transaction wallet_api::join_dapp ( string dapp_name, string ac
       custom_operation.required_active_auths.insert( account_name );
 
       signed_transaction trx;
-      trx.operations.push_back( custom_operation );
+      trx.operations.push_back( my->make_custom_operation( custom_operation, dapp_op ) );
       trx.validate();
 
       return my->sign_transaction( trx, broadcast );
@@ -2808,7 +2835,7 @@ annotated_signed_transaction wallet_api::leave_dapp ( string dapp_name, string a
       custom_operation.required_active_auths.insert( account_name );
 
       signed_transaction trx;
-      trx.operations.push_back( custom_operation );
+      trx.operations.push_back( my->make_custom_operation( custom_operation, dapp_op ) );
       trx.validate();
 
       return my->sign_transaction( trx, broadcast );
@@ -2834,7 +2861,7 @@ annotated_signed_transaction wallet_api::vote_dapp ( string voter, string dapp_n
       custom_operation.required_active_auths.insert( voter );
 
       signed_transaction trx;
-      trx.operations.push_back( custom_operation );
+      trx.operations.push_back( my->make_custom_operation( custom_operation, dapp_op ) );
       trx.validate();
 
       return my->sign_transaction( trx, broadcast );
@@ -2859,7 +2886,7 @@ annotated_signed_transaction wallet_api::vote_dapp_transaction_fee ( string vote
       custom_operation.required_active_auths.insert( voter );
 
       signed_transaction trx;
-      trx.operations.push_back( custom_operation );
+      trx.operations.push_back( my->make_custom_operation( custom_operation, dapp_op ) );
       trx.validate();
 
       return my->sign_transaction( trx, broadcast );
@@ -2932,6 +2959,22 @@ map< uint32_t, applied_operation > wallet_api::get_dapp_history( string dapp_nam
             }
          } catch( const fc::exception& ) {
          }
+      } else if( item.second.op.which() == operation::tag< custom_binary_operation >::value ) {
+         auto& custom_op = item.second.op.get< custom_binary_operation >();
+         if( custom_op.id != TOKEN_PLUGIN_NAME )
+            continue;
+
+         try{
+            auto inner_ops = fc::raw::unpack< vector< token_operation > >( custom_op.data );
+            for( auto& inner_op : inner_ops ) {
+               if( inner_op.which() == token_operation::tag< transfer_token_operation >::value ) {
+                  auto& transfer_op = inner_op.get< transfer_token_operation >();
+                  transfer_op.memo = decrypt_memo( transfer_op.memo );
+               }
+            }
+            custom_op.data = fc::raw::pack( inner_ops );
+         } catch( const fc::exception& ) {
+         }
       }
    }
    return result;
@@ -0,0 +1,539 @@
+/**
+ *  Generates a synthetic chain with the debug_node plugin and replays it into a second node, entirely offline.
+ *
+ *  The generating node starts at genesis and produces every block with the init bobserver key, so the chain
+ *  carries no debug edits and replays on a fresh database with full validation. Setup blocks create the accounts,
+ *  fund them and create a dapp and its token, then every block carries transactions-per-block transactions drawn
+ *  from the op mix:
+ *
+ *    transfer   PIA transfer between two accounts
+ *    token      transfer_token of the bench token
+ *    comment    comment_dapp root post in the bench dapp
+ *    savings    transfer_savings that completes one minute later, so withdraws are processed during the run
+ *
+ *  Plugin operations of the op mix are sent as custom_binary_operation, or as custom_json_operation with
+ *  --custom-op-encoding json, both of which the chain accepts before hardfork 0.2. The replay pushes every block
+ *  through database::push_block and reports blocks/s, ops/s, bytes per block, the p50/p99/max latency of applying
+ *  one block and how much of the shared memory file the chain state grew by.
+ */
+
+#include <futurepia/app/application.hpp>
+#include <futurepia/app/plugin.hpp>
+#include <futurepia/chain/database.hpp>
+#include <futurepia/manifest/plugins.hpp>
+
+#include <futurepia/dapp/dapp_objects.hpp>
+#include <futurepia/dapp/dapp_operations.hpp>
+#include <futurepia/dapp/dapp_plugin.hpp>
+#include <futurepia/plugins/debug_node/debug_node_plugin.hpp>
+#include <futurepia/token/token_objects.hpp>
+#include <futurepia/token/token_operations.hpp>
+#include <futurepia/token/token_plugin.hpp>
+
+#include <graphene/utilities/key_conversion.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/io/json.hpp>
+#include <fc/io/raw.hpp>
+#include <fc/string.hpp>
+#include <fc/time.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace futurepia;
+using namespace futurepia::chain;
+namespace bpo = boost::program_options;
+
+namespace {
+
+enum op_kind { transfer_kind, token_kind, comment_kind, savings_kind, op_kind_count };
+const char* op_kind_names[ op_kind_count ] = { "transfer", "token", "comment", "savings" };
+
+const std::string bench_dapp = "benchdapp";
+const std::string bench_token = "benchtoken";
+
+/// An account posts at most once every this many blocks, comment_dapp allows one root post per account every 3s
+const uint32_t comment_block_gap = 3;
+
+std::vector< uint32_t > parse_op_mix( const std::string& mix )
+{
+   std::vector< uint32_t > weights( op_kind_count, 0 );
+   std::vector< std::string > entries;
+   boost::split( entries, mix, boost::is_any_of( "," ) );
+
+   for( const auto& entry : entries )
+   {
+      std::vector< std::string > kv;
+      boost::split( kv, entry, boost::is_any_of( "=" ) );
+      FC_ASSERT( kv.size() == 2, "op-mix entries are name=weight, got ${e}", ("e", entry) );
+
+      auto name = std::find( op_kind_names, op_kind_names + op_kind_count, boost::trim_copy( kv[0] ) );
+      FC_ASSERT( name != op_kind_names + op_kind_count, "Unknown operation ${n} in op-mix", ("n", kv[0]) );
+      weights[ name - op_kind_names ] = std::stoul( kv[1] );
+   }
+
+   uint32_t total = 0;
+   for( auto w : weights )
+      total += w;
+   FC_ASSERT( total > 0, "op-mix needs at least one operation with a weight" );
+   return weights;
+}
+
+uint64_t used_shared_memory( const database& db )
+{
+   return db.get_shared_file_size() - db.get_free_memory();
+}
+
+void register_plugins( app::application& node, const std::vector< std::string >& names )
+{
+   for( const auto& name : names )
+   {
+      node.register_abstract_plugin( futurepia::plugin::create_plugin( name, &node ) );
+      node.enable_plugin( name );
+   }
+}
+
+/// Opens the chain database of node the way application::startup does, without the p2p and RPC servers
+void open_node( app::application& node, const fc::path& dir, const bpo::variables_map& options )
+{
+   node.initialize( dir, options );
+   node.initialize_plugins( options );
+
+   auto db = node.chain_database();
+   db->set_transaction_check_threads( options.at( "transaction-check-threads" ).as< uint32_t >() );
+   db->open( dir / "blockchain", dir / "blockchain", FUTUREPIA_INIT_SUPPLY,
+             fc::parse_size( options.at( "shared-file-size" ).as< std::string >() ), chainbase::database::read_write );
+
+   node.startup_plugins();
+}
+
+class chain_generator
+{
+   public:
+      chain_generator( app::application& node, uint32_t accounts, uint32_t trx_per_block, uint64_t seed, bool binary_custom_ops )
+         : _db( *node.chain_database() ), _trx_per_block( trx_per_block ), _binary_custom_ops( binary_custom_ops ), _random( seed )
+      {
+         _plugin = node.get_plugin< futurepia::plugin::debug_node::debug_node_plugin >( "debug_node" );
+         _plugin->logging = false;
+         _debug_key = graphene::utilities::key_to_wif( _key );
+
+         for( uint32_t i = 0; i < accounts; ++i )
+            _accounts.push_back( "bench" + std::to_string( i ) );
+         _last_comment_block.resize( accounts, 0 );
+      }
+
+      /// Creates, funds and hands out tokens to the accounts, and creates the dapp the comments go to
+      void setup()
+      {
+         authority auth( 1, _key.get_public_key(), 1 );
+
+         for( const auto& name : _accounts )
+         {
+            account_create_operation op;
+            op.creator = FUTUREPIA_INIT_MINER_NAME;
+            op.new_account_name = name;
+            op.owner = auth;
+            op.active = auth;
+            op.posting = auth;
+            op.memo_key = _key.get_public_key();
+            queue( op );
+         }
+         flush();
+
+         for( const auto& name : _accounts )
+         {
+            transfer_operation op;
+            op.from = FUTUREPIA_INIT_MINER_NAME;
+            op.to = name;
+            op.amount = asset( 1000000, PIA_SYMBOL );
+            queue( op );
+         }
+         flush();
+
+         dapp::create_dapp_operation create_dapp;
+         create_dapp.owner = _accounts[0];
+         create_dapp.dapp_name = bench_dapp;
+         create_dapp.dapp_key = _key.get_public_key();
+         queue( plugin_op< dapp::dapp_operation >( DAPP_PLUGIN_NAME, create_dapp, _accounts[0], false ) );
+         flush();
+
+         token::create_token_operation create_token;
+         create_token.name = bench_token;
+         create_token.symbol_name = "BENCH";
+         create_token.publisher = _accounts[0];
+         create_token.dapp_key = _key.get_public_key();
+         create_token.dapp_name = bench_dapp;
+         create_token.init_supply_amount = 1000000000;
+
+         std::vector< token::token_operation > inner( 1, create_token );
+         custom_binary_operation create_token_op;
+         create_token_op.id = TOKEN_PLUGIN_NAME;
+         create_token_op.required_auths.push_back( auth );
+         create_token_op.data = fc::raw::pack( inner );
+         queue( create_token_op );
+         flush();
+
+         // Plugin operations that fail are dropped silently outside of block production, check they took effect
+         const auto* dapp_obj = _db.find< dapp::dapp_object, dapp::by_name >( dapp_name_type( bench_dapp ) );
+         FC_ASSERT( dapp_obj != nullptr, "The bench dapp was not created" );
+         const auto* token_obj = _db.find< token::token_object, token::by_name >( token_name_type( bench_token ) );
+         FC_ASSERT( token_obj != nullptr, "The bench token was not created" );
+         _token_symbol = token_obj->symbol;
+
+         for( size_t i = 1; i < _accounts.size(); ++i )
+         {
+            token::transfer_token_operation op;
+            op.from = _accounts[0];
+            op.to = _accounts[i];
+            op.amount = asset( 10000000, _token_symbol );
+            queue( plugin_op< token::token_operation >( TOKEN_PLUGIN_NAME, op, _accounts[0], false ) );
+         }
+         flush();
+
+         _ops.assign( op_kind_count, 0 );
+      }
+
+      /// Generates count blocks of transactions drawn from the op mix
+      void generate( uint32_t count, const std::vector< uint32_t >& weights )
+      {
+         std::discrete_distribution< uint32_t > pick_kind( weights.begin(), weights.end() );
+         std::uniform_int_distribution< size_t > pick_account( 0, _accounts.size() - 1 );
+
+         for( uint32_t b = 0; b < count; ++b )
+         {
+            uint32_t block_num = _db.head_block_num() + 1;
+
+            for( uint32_t t = 0; t < _trx_per_block; ++t )
+            {
+               size_t from = pick_account( _random );
+               size_t to = pick_account( _random );
+               uint32_t kind = pick_kind( _random );
+
+               if( kind == comment_kind )
+               {
+                  // Look for an author that has not posted in the last few blocks, or send a transfer instead
+                  for( uint32_t tries = 0; tries < 8 && block_num - _last_comment_block[ from ] < comment_block_gap; ++tries )
+                     from = pick_account( _random );
+                  if( _last_comment_block[ from ] != 0 && block_num - _last_comment_block[ from ] < comment_block_gap )
+                     kind = transfer_kind;
+               }
+
+               switch( kind )
+               {
+                  case transfer_kind:
+                  {
+                     transfer_operation op;
+                     op.from = _accounts[ from ];
+                     op.to = _accounts[ to ];
+                     op.amount = asset( 1, PIA_SYMBOL );
+                     op.memo = std::to_string( _counter++ );
+                     queue( op );
+                     break;
+                  }
+                  case token_kind:
+                  {
+                     token::transfer_token_operation op;
+                     op.from = _accounts[ from ];
+                     op.to = _accounts[ to ];
+                     op.amount = asset( 1, _token_symbol );
+                     op.memo = std::to_string( _counter++ );
+                     queue( plugin_op< token::token_operation >( TOKEN_PLUGIN_NAME, op, op.from, false ) );
+                     break;
+                  }
+                  case comment_kind:
+                  {
+                     dapp::comment_dapp_operation op;
+                     op.dapp_name = bench_dapp;
+                     op.parent_author = FUTUREPIA_ROOT_POST_PARENT;
+                     op.parent_permlink = "bench";
+                     op.author = _accounts[ from ];
+                     op.permlink = "p" + std::to_string( _counter++ );
+                     op.title = "futurepia_bench";
+                     op.body = "Synthetic dapp comment generated by futurepia_bench";
+                     queue( plugin_op< dapp::dapp_operation >( DAPP_PLUGIN_NAME, op, op.author, true ) );
+                     _last_comment_block[ from ] = block_num;
+                     break;
+                  }
+                  case savings_kind:
+                  {
+                     transfer_savings_operation op;
+                     op.from = _accounts[ from ];
+                     op.to = _accounts[ to ];
+                     op.request_id = _counter++;
+                     op.amount = asset( 1, PIA_SYMBOL );
+                     op.total_amount = op.amount;
+                     op.split_pay_order = 1;
+                     op.split_pay_month = 1;
+                     op.complete = _db.head_block_time() + fc::seconds( 60 );
+                     queue( op );
+                     break;
+                  }
+               }
+
+               ++_ops[ kind ];
+            }
+
+            flush();
+         }
+      }
+
+      const std::vector< uint64_t >& ops()const { return _ops; }
+
+   private:
+      template< typename OperationType, typename InnerType >
+      operation plugin_op( const std::string& id, const InnerType& op, const account_name_type& auth, bool posting )
+      {
+         std::vector< OperationType > inner( 1, op );
+
+         if( !_binary_custom_ops )
+         {
+            custom_json_operation result;
+            result.id = id;
+            if( posting )
+               result.required_posting_auths.insert( auth );
+            else
+               result.required_auths.insert( auth );
+            result.json = fc::json::to_string( inner );
+            return result;
+         }
+
+         custom_binary_operation result;
+         result.id = id;
+         if( posting )
+            result.required_posting_auths.insert( auth );
+         else
+            result.required_active_auths.insert( auth );
+         result.data = fc::raw::pack( inner );
+         return result;
+      }
+
+      /// Pushes op in its own signed transaction, blocks are produced once a block worth of them is pending
+      void queue( const operation& op )
+      {
+         signed_transaction trx;
+         trx.operations.push_back( op );
+         trx.set_reference_block( _db.head_block_id() );
+         trx.set_expiration( _db.head_block_time() + fc::seconds( 60 ) );
+         trx.sign( _key, FUTUREPIA_CHAIN_ID );
+         _db.push_transaction( trx );
+
+         if( ++_pending == _trx_per_block )
+            flush();
+      }
+
+      void flush()
+      {
+         if( _pending == 0 )
+            return;
+         _plugin->debug_generate_blocks( _debug_key, 1 );
+         _pending = 0;
+      }
+
+      database&                                _db;
+      std::shared_ptr< futurepia::plugin::debug_node::debug_node_plugin > _plugin;
+
+      fc::ecc::private_key                     _key = FUTUREPIA_INIT_PRIVATE_KEY;
+      std::string                              _debug_key;
+      uint32_t                                 _trx_per_block;
+      bool                                     _binary_custom_ops;
+      uint32_t                                 _pending = 0;
+      uint64_t                                 _counter = 0;
+      std::mt19937_64                          _random;
+
+      std::vector< account_name_type >         _accounts;
+      std::vector< uint32_t >                  _last_comment_block;
+      asset_symbol_type                        _token_symbol = 0;
+      std::vector< uint64_t >                  _ops;
+};
+
+int64_t percentile( const std::vector< int64_t >& sorted, double p )
+{
+   if( sorted.empty() )
+      return 0;
+   return sorted[ std::min< size_t >( sorted.size() - 1, size_t( p * sorted.size() ) ) ];
+}
+
+}
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      futurepia::plugin::initialize_plugin_factories();
+
+      // The generating node produces the chain, the replay node only runs the plugins the operations need
+      std::unique_ptr< app::application > gen_node( new app::application() );
+      std::unique_ptr< app::application > replay_node( new app::application() );
+      register_plugins( *gen_node, { DAPP_PLUGIN_NAME, "debug_node", TOKEN_PLUGIN_NAME } );
+      register_plugins( *replay_node, { DAPP_PLUGIN_NAME, TOKEN_PLUGIN_NAME } );
+
+      bpo::options_description bench_options( "futurepia_bench" );
+      bench_options.add_options()
+            ("help,h", "Print this help message and exit.")
+            ("data-dir,d", bpo::value< std::string >(), "Directory for the generated and replayed chains, a temporary directory by default")
+            ("accounts", bpo::value< uint32_t >()->default_value( 1000 ), "Number of accounts the operations are spread over")
+            ("blocks", bpo::value< uint32_t >()->default_value( 1000 ), "Number of blocks generated with the op mix, after the setup blocks")
+            ("transactions-per-block", bpo::value< uint32_t >()->default_value( 100 ), "Transactions in each generated block, one operation each")
+            ("op-mix", bpo::value< std::string >()->default_value( "transfer=40,token=30,comment=20,savings=10" ), "Relative weights of the generated operations, of transfer, token, comment and savings")
+            ("seed", bpo::value< uint64_t >()->default_value( 1 ), "Seed of the operation generator")
+            ("trusted-replay", "Replay with the checks a reindex skips, signatures, authorities and operation validation")
+            ("custom-op-encoding", bpo::value< std::string >()->default_value( "binary" ), "How token and dapp operations are sent, binary (custom_binary_operation) or json (custom_json_operation)")
+            ;
+
+      bpo::options_description node_cli, node_cfg;
+      gen_node->set_program_options( node_cli, node_cfg );
+      bench_options.add( node_cli ).add( node_cfg );
+
+      bpo::variables_map options;
+      bpo::store( bpo::parse_command_line( argc, argv, bench_options ), options );
+      bpo::notify( options );
+
+      if( options.count( "help" ) )
+      {
+         std::cout << bench_options << "\n";
+         return 0;
+      }
+
+      uint32_t accounts = options.at( "accounts" ).as< uint32_t >();
+      uint32_t blocks = options.at( "blocks" ).as< uint32_t >();
+      uint32_t trx_per_block = options.at( "transactions-per-block" ).as< uint32_t >();
+      std::vector< uint32_t > weights = parse_op_mix( options.at( "op-mix" ).as< std::string >() );
+      FC_ASSERT( accounts > 0 && trx_per_block > 0 );
+
+      std::string encoding = options.at( "custom-op-encoding" ).as< std::string >();
+      FC_ASSERT( encoding == "binary" || encoding == "json", "custom-op-encoding is binary or json, got ${e}", ("e", encoding) );
+
+      std::unique_ptr< fc::temp_directory > temp_dir;
+      fc::path data_dir;
+      if( options.count( "data-dir" ) )
+      {
+         data_dir = fc::path( options.at( "data-dir" ).as< std::string >() );
+         FC_ASSERT( !fc::exists( data_dir / "generated" ) && !fc::exists( data_dir / "replayed" ), "${d} already holds a bench run", ("d", data_dir) );
+      }
+      else
+      {
+         temp_dir.reset( new fc::temp_directory( fc::temp_directory_path() ) );
+         data_dir = temp_dir->path();
+      }
+
+      /// Generate
+      open_node( *gen_node, data_dir / "generated", options );
+      auto gen_db = gen_node->chain_database();
+
+      chain_generator generator( *gen_node, accounts, trx_per_block, options.at( "seed" ).as< uint64_t >(), encoding == "binary" );
+
+      auto start = fc::time_point::now();
+      generator.setup();
+      uint32_t setup_blocks = gen_db->head_block_num();
+      auto setup_elapsed = fc::time_point::now() - start;
+
+      start = fc::time_point::now();
+      generator.generate( blocks, weights );
+      auto gen_elapsed = std::max< int64_t >( ( fc::time_point::now() - start ).count(), 1 );
+
+      uint32_t head = gen_db->head_block_num();
+      std::cout << "setup: " << setup_blocks << " blocks, " << accounts << " accounts in " << setup_elapsed.count() / 1000 << " ms\n";
+      std::cout << "generate: " << blocks << " blocks, " << uint64_t( double( blocks ) * 1000000 / gen_elapsed ) << " blocks/s, "
+                << uint64_t( double( blocks ) * trx_per_block * 1000000 / gen_elapsed ) << " ops/s\n";
+      std::cout << "op mix:";
+      for( uint32_t k = 0; k < op_kind_count; ++k )
+         std::cout << " " << op_kind_names[ k ] << "=" << generator.ops()[ k ];
+      std::cout << "\n";
+
+      /// Replay
+      open_node( *replay_node, data_dir / "replayed", options );
+      auto replay_db = replay_node->chain_database();
+
+      uint32_t skip = database::skip_nothing;
+      if( options.count( "trusted-replay" ) )
+      {
+         skip = database::skip_bobserver_signature |
+                database::skip_transaction_signatures |
+                database::skip_transaction_dupe_check |
+                database::skip_tapos_check |
+                database::skip_merkle_check |
+                database::skip_bobserver_schedule_check |
+                database::skip_authority_check |
+                database::skip_validate |
+                database::skip_validate_invariants;
+      }
+
+      std::vector< int64_t > latencies;
+      latencies.reserve( head );
+      uint64_t ops = 0;
+      uint64_t bytes = 0;
+      uint64_t used_at_setup = used_shared_memory( *replay_db );
+
+      for( uint32_t block_num = 1; block_num <= head; ++block_num )
+      {
+         fc::optional< signed_block > block = gen_db->fetch_block_by_number( block_num );
+         FC_ASSERT( block.valid(), "Generated chain is missing block ${n}", ("n", block_num) );
+
+         auto block_start = fc::time_point::now();
+         replay_db->push_block( *block, skip );
+         auto elapsed = ( fc::time_point::now() - block_start ).count();
+
+         uint64_t block_ops = 0;
+         for( const auto& trx : block->transactions )
+            block_ops += trx.operations.size();
+
+         // Only the op mix blocks are timed, the setup blocks run different operations
+         if( block_num <= setup_blocks )
+         {
+            if( block_num == setup_blocks )
+               used_at_setup = used_shared_memory( *replay_db );
+            continue;
+         }
+
+         latencies.push_back( elapsed );
+         ops += block_ops;
+         bytes += fc::raw::pack_size( *block );
+      }
+
+      FC_ASSERT( replay_db->head_block_id() == gen_db->head_block_id(), "Replay ended on a different head block" );
+
+      int64_t total = 0;
+      for( auto l : latencies )
+         total += l;
+      total = std::max< int64_t >( total, 1 );
+      std::sort( latencies.begin(), latencies.end() );
+
+      uint64_t used_at_end = used_shared_memory( *replay_db );
+
+      std::cout << "replay: " << latencies.size() << " blocks, " << ops << " ops in " << total / 1000 << " ms, "
+                << uint64_t( double( latencies.size() ) * 1000000 / total ) << " blocks/s, "
+                << uint64_t( double( ops ) * 1000000 / total ) << " ops/s"
+                << ( skip == database::skip_nothing ? "" : ", trusted" ) << "\n";
+      std::cout << "block size: " << ( latencies.empty() ? 0 : bytes / latencies.size() ) << " bytes per block, "
+                << ( ops == 0 ? 0 : bytes / ops ) << " bytes per op, " << encoding << " custom operations\n";
+      std::cout << "block apply latency: p50 " << percentile( latencies, 0.5 ) << " us, p99 " << percentile( latencies, 0.99 )
+                << " us, max " << ( latencies.empty() ? 0 : latencies.back() ) << " us\n";
+      std::cout << "shared memory: " << used_at_setup / 1024 << " KiB after setup, " << used_at_end / 1024 << " KiB at the end, "
+                << ( latencies.empty() ? 0 : ( used_at_end - used_at_setup ) / latencies.size() ) << " bytes per block\n";
+
+      replay_node->shutdown_plugins();
+      replay_db->close();
+      gen_node->shutdown_plugins();
+      gen_db->close();
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   catch( const boost::program_options::error& e )
+   {
+      std::cerr << "Error parsing command line: " << e.what() << "\n";
+      return 1;
+   }
+   return 0;
+}
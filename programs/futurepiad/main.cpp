@@ -251,7 +251,11 @@ void write_default_logging_config_to_stream(std::ostream& out)
           "# stream=std_error\n"
           "[log.file_appender.stderr]\n"
           "filename=logs/stderr/stderr.log\n"
-          "limit_days=7\n\n"
+          "limit_days=7\n"
+          "# format and write messages on a background thread, messages that do not fit in\n"
+          "# queue_size are dropped and counted\n"
+          "# async=true\n"
+          "# queue_size=8192\n\n"
           "# declare an appender named \"p2p\" that writes messages to p2p.log\n"
           "[log.file_appender.p2p]\n"
           "filename=logs/p2p/p2p.log\n"
@@ -324,6 +328,8 @@ fc::optional<fc::logging_config> load_logging_config_from_ini_file(const fc::pat
             file_appender_config.rotate = true;
             file_appender_config.rotation_interval = fc::hours(1);
             file_appender_config.rotation_limit = fc::days( limit_days ); 
+            file_appender_config.async = section_tree.get< bool >( "async", false );
+            file_appender_config.queue_size = section_tree.get< uint32_t >( "queue_size", file_appender_config.queue_size );
             logging_config.appenders.push_back(fc::appender_config(file_appender_name, "file", fc::variant(file_appender_config)));
             found_logging_config = true;
          }
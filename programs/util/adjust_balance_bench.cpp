@@ -0,0 +1,81 @@
+/**
+ *  Measures the throughput of database::adjust_balance, adjust_savings_balance and adjust_exchange_balance
+ *  on a scratch database, the way they are called while applying a block (inside an undo session).
+ *
+ *  usage: adjust_balance_bench [accounts] [iterations]
+ */
+
+#include <futurepia/chain/account_object.hpp>
+#include <futurepia/chain/database.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace futurepia::chain;
+using futurepia::protocol::asset;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      uint32_t account_count = argc > 1 ? std::stoul( argv[1] ) : 100000;
+      uint32_t iterations = argc > 2 ? std::stoul( argv[2] ) : 1000000;
+
+      fc::temp_directory data_dir( fc::temp_directory_path() );
+
+      database db;
+      db.open( data_dir.path(), data_dir.path(), FUTUREPIA_INIT_SUPPLY, 1024l*1024l*1024l*4l, chainbase::database::read_write );
+
+      std::vector< const account_object* > accounts;
+      accounts.reserve( account_count );
+
+      db.with_write_lock( [&]()
+      {
+         for( uint32_t i = 0; i < account_count; ++i )
+         {
+            accounts.push_back( &db.create< account_object >( [&]( account_object& a )
+            {
+               a.name = "bench" + std::to_string( i );
+               a.balance = asset( i % 1000, PIA_SYMBOL );
+               a.snac_balance = asset( i % 1000, SNAC_SYMBOL );
+            }) );
+         }
+      });
+
+      auto run = [&]( const char* name, std::function< void( const account_object&, const asset& ) > adjust )
+      {
+         db.with_write_lock( [&]()
+         {
+            auto session = db.start_undo_session( true );
+
+            auto start = fc::time_point::now();
+            for( uint32_t i = 0; i < iterations; ++i )
+               adjust( *accounts[ i % account_count ], i & 1 ? asset( 1, SNAC_SYMBOL ) : asset( 1, PIA_SYMBOL ) );
+            auto elapsed = fc::time_point::now() - start;
+
+            session.undo();
+
+            std::cout << name << ": " << iterations << " calls in " << elapsed.count() / 1000 << " ms, "
+                      << uint64_t( double( iterations ) * 1000000 / std::max< int64_t >( elapsed.count(), 1 ) ) << " calls/s\n";
+         });
+      };
+
+      run( "adjust_balance", [&]( const account_object& a, const asset& d ){ db.adjust_balance( a, d ); } );
+      run( "adjust_savings_balance", [&]( const account_object& a, const asset& d ){ db.adjust_savings_balance( a, d ); } );
+      run( "adjust_exchange_balance", [&]( const account_object& a, const asset& d ){ db.adjust_exchange_balance( a, d ); } );
+
+      db.close();
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
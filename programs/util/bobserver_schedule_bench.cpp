@@ -0,0 +1,88 @@
+/**
+ *  Measures update_bobserver_schedule against a chain with many bobservers. A fresh chain is created in a
+ *  temporary directory and filled with bobservers, a share of them block producers, then every round changes
+ *  the signing key of a few bobservers, as key updates and exceptions do, and computes the next schedule.
+ *
+ *  usage: bobserver_schedule_bench [bobservers] [rounds] [changes_per_round]
+ */
+
+#include <futurepia/chain/bobserver_objects.hpp>
+#include <futurepia/chain/bobserver_schedule.hpp>
+#include <futurepia/chain/database.hpp>
+
+#include <fc/crypto/elliptic.hpp>
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace futurepia::chain;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      uint32_t bobserver_count = argc > 1 ? std::stoul( argv[1] ) : 50000;
+      uint32_t rounds = argc > 2 ? std::stoul( argv[2] ) : 1000;
+      uint32_t changes = argc > 3 ? std::stoul( argv[3] ) : 10;
+
+      fc::temp_directory data_dir;
+      database db;
+      db.open( data_dir.path(), data_dir.path(), FUTUREPIA_INIT_SUPPLY, 1024ull * 1024 * 1024, chainbase::database::read_write );
+
+      public_key_type key = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "bobserver" ) ) ).get_public_key();
+
+      db.with_write_lock( [&]()
+      {
+         for( uint32_t i = 0; i < bobserver_count; ++i )
+         {
+            db.create< bobserver_object >( [&]( bobserver_object& o )
+            {
+               o.account = "bench" + std::to_string( i );
+               o.signing_key = key;
+               o.is_bproducer = i % 100 == 0;
+               o.created = db.head_block_time();
+            });
+         }
+      });
+
+      std::cout << bobserver_count << " bobservers, " << changes << " key changes per round\n";
+
+      uint64_t total = 0;
+      auto start = fc::time_point::now();
+      db.with_write_lock( [&]()
+      {
+         for( uint32_t r = 0; r < rounds; ++r )
+         {
+            for( uint32_t c = 0; c < changes; ++c )
+            {
+               const auto& bo = db.get_bobserver( "bench" + std::to_string( ( uint64_t( r ) * changes + c ) * 7919 % bobserver_count ) );
+               db.modify( bo, [&]( bobserver_object& o )
+               {
+                  o.signing_key = o.has_signing_key() ? public_key_type() : key;
+               });
+            }
+
+            update_bobserver_schedule( db );
+            total += db.get_bobserver_schedule_object().num_scheduled_bobservers;
+         }
+      });
+      auto elapsed = std::max< int64_t >( ( fc::time_point::now() - start ).count(), 1 );
+
+      std::cout << "rounds: " << rounds << " in " << elapsed / 1000 << " ms, "
+                << elapsed / rounds << " us/round\n";
+
+      // Keeps the loop from being optimized away
+      std::cout << "checksum " << total << "\n";
+
+      db.close();
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ *  Compares token operations sent as custom_json_hf2_operation and as fc::raw packed custom_binary_operation.
+ *
+ *  For each encoding it reports the packed size of a transaction carrying one transfer_token operation, which is
+ *  what it adds to a block, and how fast the inner operations are decoded and validated. Decoding is the only part
+ *  of applying the operation that differs between the two encodings, the evaluator work is the same. Apply
+ *  throughput and bytes of whole blocks are measured by futurepia_bench --custom-op-encoding binary|json.
+ *
+ *  usage: custom_op_encoding_bench [iterations] [ops_per_custom_op]
+ */
+
+#include <futurepia/protocol/transaction.hpp>
+#include <futurepia/protocol/operation_util_impl.hpp>
+
+#include <futurepia/token/token_operations.hpp>
+#include <futurepia/token/token_plugin.hpp>
+
+#include <fc/io/json.hpp>
+#include <fc/io/raw.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace futurepia::protocol;
+using namespace futurepia::token;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      uint32_t iterations = argc > 1 ? std::stoul( argv[1] ) : 100000;
+      uint32_t ops_per_custom_op = argc > 2 ? std::stoul( argv[2] ) : 1;
+
+      transfer_token_operation transfer;
+      transfer.from = "benchfrom";
+      transfer.to = "benchto";
+      transfer.amount = asset::from_string( "12.345 BENCH" );
+      transfer.memo = "custom operation encoding benchmark";
+
+      std::vector< token_operation > inner_ops( ops_per_custom_op, token_operation( transfer ) );
+
+      custom_json_hf2_operation json_op;
+      json_op.id = TOKEN_PLUGIN_NAME;
+      json_op.required_active_auths.insert( transfer.from );
+      json_op.json = fc::json::to_string( inner_ops );
+
+      custom_binary_operation binary_op;
+      binary_op.id = TOKEN_PLUGIN_NAME;
+      binary_op.required_active_auths.insert( transfer.from );
+      binary_op.data = fc::raw::pack( inner_ops );
+
+      auto trx_size = [&]( const operation& op )
+      {
+         signed_transaction trx;
+         trx.operations.push_back( op );
+         return fc::raw::pack_size( trx );
+      };
+
+      auto run = [&]( const char* name, size_t bytes, std::function< void() > decode )
+      {
+         auto start = fc::time_point::now();
+         for( uint32_t i = 0; i < iterations; ++i )
+            decode();
+         auto elapsed = fc::time_point::now() - start;
+
+         std::cout << name << ": " << bytes << " bytes per transaction, " << iterations << " decodes in "
+                   << elapsed.count() / 1000 << " ms, "
+                   << uint64_t( double( iterations ) * 1000000 / std::max< int64_t >( elapsed.count(), 1 ) ) << " decodes/s\n";
+      };
+
+      run( "custom_json_hf2", trx_size( json_op ), [&]()
+      {
+         // Same steps as generic_custom_operation_interpreter for a JSON payload
+         fc::variant v = fc::json::from_string( json_op.json );
+         std::vector< token_operation > ops;
+         from_variant( v, ops );
+         for( const auto& op : ops )
+            operation_validate( op );
+      });
+
+      run( "custom_binary", trx_size( binary_op ), [&]()
+      {
+         auto ops = fc::raw::unpack< std::vector< token_operation > >( binary_op.data );
+         for( const auto& op : ops )
+            operation_validate( op );
+      });
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ *  Measures the hashes the chain computes most: fc::sha256, fc::sha224 and fc::ripemd160 over flat buffers of a
+ *  few sizes, sha256::hash_batch against one call per message, transaction ids, which stream fc::raw::pack into
+ *  an encoder a field at a time, and signed_block::calculate_merkle_root.
+ *
+ *  usage: hash_bench [iterations] [transactions_per_block]
+ */
+
+#include <futurepia/protocol/block.hpp>
+#include <futurepia/protocol/futurepia_operations.hpp>
+
+#include <fc/crypto/ripemd160.hpp>
+#include <fc/crypto/sha224.hpp>
+#include <fc/crypto/sha256.hpp>
+#include <fc/time.hpp>
+
+#include <openssl/opensslv.h>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace futurepia::protocol;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      uint32_t iterations = argc > 1 ? std::stoul( argv[1] ) : 1000000;
+      uint32_t trx_count = argc > 2 ? std::stoul( argv[2] ) : 1000;
+
+      std::cout << OPENSSL_VERSION_TEXT << "\n";
+
+      auto run = [&]( const std::string& name, uint32_t count, std::function< void( uint32_t ) > step )
+      {
+         auto start = fc::time_point::now();
+         for( uint32_t i = 0; i < count; ++i )
+            step( i );
+         auto elapsed = fc::time_point::now() - start;
+
+         std::cout << name << ": " << count << " in " << elapsed.count() / 1000 << " ms, "
+                   << uint64_t( double( count ) * 1000000 / std::max< int64_t >( elapsed.count(), 1 ) ) << " /s\n";
+      };
+
+      std::vector< char > data( 1024 * 64 );
+      for( size_t i = 0; i < data.size(); ++i )
+         data[i] = char( i * 31 );
+
+      for( uint32_t size : { 32, 64, 256, 1024 } )
+      {
+         // Each hash feeds the next one so the loop cannot be folded away
+         fc::sha256 h256;
+         run( "sha256 " + std::to_string( size ) + " bytes", iterations, [&]( uint32_t )
+         {
+            h256 = fc::sha256::hash( data.data(), size );
+            data[0] = h256.data()[0];
+         });
+
+         fc::sha224 h224;
+         run( "sha224 " + std::to_string( size ) + " bytes", iterations, [&]( uint32_t )
+         {
+            h224 = fc::sha224::hash( data.data(), size );
+            data[0] = h224.data()[0];
+         });
+
+         fc::ripemd160 h160;
+         run( "ripemd160 " + std::to_string( size ) + " bytes", iterations, [&]( uint32_t )
+         {
+            h160 = fc::ripemd160::hash( data.data(), size );
+            data[0] = h160.data()[0];
+         });
+      }
+
+      // One merkle tree level, 64 byte messages
+      const uint32_t batch = data.size() / 64;
+      std::vector< fc::sha256 > out( batch );
+      run( "sha256 64 bytes, one call per message", iterations / batch, [&]( uint32_t )
+      {
+         for( uint32_t i = 0; i < batch; ++i )
+            out[i] = fc::sha256::hash( data.data() + i * 64, 64 );
+         data[0] = out[0].data()[0];
+      });
+      run( "sha256 64 bytes, hash_batch of " + std::to_string( batch ), iterations / batch, [&]( uint32_t )
+      {
+         fc::sha256::hash_batch( data.data(), 64, batch, out.data() );
+         data[0] = out[0].data()[0];
+      });
+
+      signed_block block;
+      for( uint32_t i = 0; i < trx_count; ++i )
+      {
+         transfer_operation op;
+         op.from = "benchfrom";
+         op.to = "benchto";
+         op.amount = asset( i + 1, PIA_SYMBOL );
+         op.memo = "hash benchmark";
+
+         signed_transaction trx;
+         trx.ref_block_num = uint16_t( i );
+         trx.expiration = fc::time_point_sec( 1500000000 + i );
+         trx.operations.push_back( op );
+         block.transactions.push_back( trx );
+      }
+
+      transaction_id_type id;
+      run( "transaction id", iterations, [&]( uint32_t i )
+      {
+         id = block.transactions[ i % trx_count ].id();
+      });
+
+      checksum_type root;
+      run( "merkle root of " + std::to_string( trx_count ) + " transactions", std::max< uint32_t >( iterations / trx_count, 1 ), [&]( uint32_t )
+      {
+         root = block.calculate_merkle_root();
+      });
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ *  Measures the latency of random account lookups by name, which walk the by_name tree of the account index,
+ *  for a given way of mapping the shared memory file. Run it once per mode to compare, pointing dir at a
+ *  hugetlbfs mount or at tmpfs with shmem huge pages to try huge pages.
+ *
+ *  usage: lookup_latency_bench <dir> [accounts] [lookups] [hugepage|random|willneed|populate|numa=<node>]...
+ */
+
+#include <futurepia/chain/account_object.hpp>
+#include <futurepia/chain/database.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace futurepia::chain;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      if( argc < 2 )
+      {
+         std::cerr << "usage: " << argv[0] << " <dir> [accounts] [lookups] [hugepage|random|willneed|populate|numa=<node>]...\n";
+         return 1;
+      }
+
+      fc::path dir = fc::path( argv[1] ) / "lookup_latency_bench";
+      uint32_t account_count = argc > 2 ? std::stoul( argv[2] ) : 1000000;
+      uint32_t lookups = argc > 3 ? std::stoul( argv[3] ) : 1000000;
+
+      uint32_t map_flags = chainbase::database::map_default;
+      int32_t numa_node = -1;
+      for( int i = 4; i < argc; ++i )
+      {
+         std::string mode = argv[i];
+         if( mode == "hugepage" )
+            map_flags |= chainbase::database::map_hugepage;
+         else if( mode == "random" )
+            map_flags |= chainbase::database::map_random;
+         else if( mode == "willneed" )
+            map_flags |= chainbase::database::map_willneed;
+         else if( mode == "populate" )
+            map_flags |= chainbase::database::map_populate;
+         else if( mode.compare( 0, 5, "numa=" ) == 0 )
+            numa_node = std::stoi( mode.substr( 5 ) );
+         else
+            FC_THROW( "Unknown mode ${m}", ("m", mode) );
+      }
+
+      fc::remove_all( dir );
+
+      std::vector< account_name_type > names;
+      names.reserve( account_count );
+
+      {
+         database db;
+         db.open( dir, dir, FUTUREPIA_INIT_SUPPLY, 1024l*1024l*1024l*4l, chainbase::database::read_write );
+         db.with_write_lock( [&]()
+         {
+            for( uint32_t i = 0; i < account_count; ++i )
+            {
+               const auto& a = db.create< account_object >( [&]( account_object& a )
+               {
+                  a.name = "bench" + std::to_string( i );
+               });
+               names.push_back( a.name );
+            }
+         });
+         db.close();
+      }
+
+      // Reopen so the lookups run against a fresh mapping with the requested options
+      database db;
+      db.set_map_options( map_flags, numa_node );
+
+      auto open_start = fc::time_point::now();
+      db.open( dir, dir, FUTUREPIA_INIT_SUPPLY, 0, chainbase::database::read_write );
+      auto open_elapsed = fc::time_point::now() - open_start;
+
+      std::mt19937 rng( 42 );
+      std::uniform_int_distribution< uint32_t > pick( 0, account_count - 1 );
+      std::vector< uint32_t > order( lookups );
+      for( auto& i : order )
+         i = pick( rng );
+
+      uint64_t found = 0;
+      auto start = fc::time_point::now();
+      db.with_read_lock( [&]()
+      {
+         for( auto i : order )
+            found += db.find_account( names[ i ] ) != nullptr;
+      });
+      auto elapsed = std::max< int64_t >( ( fc::time_point::now() - start ).count(), 1 );
+
+      std::cout << "open: " << open_elapsed.count() / 1000 << " ms, " << lookups << " lookups over " << account_count
+                << " accounts (" << found << " found) in " << elapsed / 1000 << " ms, "
+                << double( elapsed ) * 1000 / lookups << " ns per lookup\n";
+
+      db.close();
+      fc::remove_all( dir );
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
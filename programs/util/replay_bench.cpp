@@ -0,0 +1,84 @@
+/**
+ *  Replays the blocks of an existing block log into a scratch database with transaction validation and signature
+ *  checks enabled, which is what a node does for blocks it receives, and reports the throughput. Run it with
+ *  different thread counts to compare checking transactions inline and on the transaction_preprocessor pool.
+ *
+ *  usage: replay_bench <blockchain-dir> [transaction-check-threads] [blocks]
+ */
+
+#include <futurepia/chain/block_log.hpp>
+#include <futurepia/chain/database.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace futurepia::chain;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      if( argc < 2 )
+      {
+         std::cerr << "usage: " << argv[0] << " <blockchain-dir> [transaction-check-threads] [blocks]\n";
+         return 1;
+      }
+
+      fc::path blockchain_dir = argv[1];
+      uint32_t threads = argc > 2 ? std::stoul( argv[2] ) : 0;
+      uint32_t max_blocks = argc > 3 ? std::stoul( argv[3] ) : 0;
+
+      block_log source;
+      source.open( blockchain_dir / "block_log" );
+      FC_ASSERT( source.head(), "No blocks in ${d}", ("d", blockchain_dir) );
+
+      uint32_t last_block_num = source.head()->block_num();
+      if( max_blocks )
+         last_block_num = std::min( last_block_num, max_blocks );
+
+      fc::temp_directory data_dir( fc::temp_directory_path() );
+
+      database db;
+      db.open( data_dir.path(), data_dir.path(), FUTUREPIA_INIT_SUPPLY, 1024l*1024l*1024l*8l, chainbase::database::read_write );
+      db.set_transaction_check_threads( threads );
+
+      uint32_t skip = database::skip_bobserver_signature |
+                      database::skip_bobserver_schedule_check |
+                      database::skip_fork_db |
+                      database::skip_block_log |
+                      database::skip_undo_history_check;
+
+      uint64_t transactions = 0;
+      auto itr = source.read_block( 0 );
+      auto start = fc::time_point::now();
+
+      while( true )
+      {
+         transactions += itr.first.transactions.size();
+         db.push_block( itr.first, skip );
+
+         if( itr.first.block_num() >= last_block_num )
+            break;
+         itr = source.read_block( itr.second );
+      }
+
+      auto elapsed = std::max< int64_t >( ( fc::time_point::now() - start ).count(), 1 );
+
+      std::cout << "replay: " << last_block_num << " blocks, " << transactions << " transactions in "
+                << elapsed / 1000 << " ms with " << threads << " transaction check threads, "
+                << uint64_t( double( last_block_num ) * 1000000 / elapsed ) << " blocks/s, "
+                << uint64_t( double( transactions ) * 1000000 / elapsed ) << " transactions/s\n";
+
+      db.close();
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
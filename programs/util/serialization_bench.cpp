@@ -0,0 +1,100 @@
+/**
+ *  Measures fc::raw over the blocks of an existing block log: pack_size, pack and unpack of whole blocks, which is
+ *  the work done for every block written to or read from the block log and sent over the p2p network.
+ *
+ *  usage: serialization_bench <blockchain-dir> [blocks] [rounds]
+ */
+
+#include <futurepia/chain/block_log.hpp>
+
+#include <fc/io/raw.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace futurepia::chain;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      if( argc < 2 )
+      {
+         std::cerr << "usage: " << argv[0] << " <blockchain-dir> [blocks] [rounds]\n";
+         return 1;
+      }
+
+      fc::path blockchain_dir = argv[1];
+      uint32_t max_blocks = argc > 2 ? std::stoul( argv[2] ) : 100000;
+      uint32_t rounds = argc > 3 ? std::stoul( argv[3] ) : 5;
+
+      block_log source;
+      source.open( blockchain_dir / "block_log" );
+      FC_ASSERT( source.head(), "No blocks in ${d}", ("d", blockchain_dir) );
+
+      uint32_t last_block_num = std::min( source.head()->block_num(), max_blocks );
+
+      std::vector< signed_block > blocks;
+      std::vector< std::vector< char > > packed;
+      blocks.reserve( last_block_num );
+      packed.reserve( last_block_num );
+
+      uint64_t bytes = 0;
+      uint64_t trx_count = 0;
+      for( uint32_t block_num = 1; block_num <= last_block_num; ++block_num )
+      {
+         auto block = source.read_block_by_num( block_num );
+         FC_ASSERT( block, "Missing block ${n}", ("n", block_num) );
+         packed.push_back( fc::raw::pack( *block ) );
+         bytes += packed.back().size();
+         trx_count += block->transactions.size();
+         blocks.push_back( std::move( *block ) );
+      }
+      source.close();
+
+      std::cout << blocks.size() << " blocks, " << trx_count << " transactions, " << bytes << " bytes\n";
+
+      auto run = [&]( const char* name, std::function< void() > step )
+      {
+         auto start = fc::time_point::now();
+         for( uint32_t r = 0; r < rounds; ++r )
+            step();
+         auto elapsed = std::max< int64_t >( ( fc::time_point::now() - start ).count(), 1 );
+
+         std::cout << name << ": " << uint64_t( double( blocks.size() ) * rounds * 1000000 / elapsed ) << " blocks/s, "
+                   << uint64_t( double( bytes ) * rounds / elapsed ) << " MB/s\n";
+      };
+
+      uint64_t total = 0;
+      run( "pack_size", [&]()
+      {
+         for( const auto& b : blocks )
+            total += fc::raw::pack_size( b );
+      });
+
+      run( "pack", [&]()
+      {
+         for( const auto& b : blocks )
+            total += fc::raw::pack( b ).size();
+      });
+
+      run( "unpack", [&]()
+      {
+         for( const auto& p : packed )
+            total += fc::raw::unpack< signed_block >( p ).transactions.size();
+      });
+
+      // Keeps the loops from being optimized away
+      std::cout << "checksum " << total << "\n";
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ *  Measures token balance updates the way transfer_token_evaluator does them, a debit of the sender and a credit
+ *  of the receiver through token_util, on a scratch database inside an undo session.
+ *
+ *  usage: token_transfer_bench [accounts] [iterations]
+ */
+
+#include <futurepia/chain/account_object.hpp>
+#include <futurepia/chain/database.hpp>
+#include <futurepia/chain/index.hpp>
+
+#include <futurepia/token/token_objects.hpp>
+#include <futurepia/token/util/token_util.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/time.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace futurepia::chain;
+using namespace futurepia::token;
+using futurepia::protocol::asset;
+
+int main( int argc, char** argv )
+{
+   try
+   {
+      uint32_t account_count = argc > 1 ? std::stoul( argv[1] ) : 100000;
+      uint32_t iterations = argc > 2 ? std::stoul( argv[2] ) : 1000000;
+
+      fc::temp_directory data_dir( fc::temp_directory_path() );
+
+      database db;
+      add_plugin_index< token_balance_index >( db );
+      db.open( data_dir.path(), data_dir.path(), FUTUREPIA_INIT_SUPPLY, 1024l*1024l*1024l*4l, chainbase::database::read_write );
+
+      const token_name_type token = "benchtoken";
+      const asset initial = asset::from_string( "1000000.000 BENCH" );
+      const asset amount = asset( 1, initial.symbol );
+
+      std::vector< account_name_type > accounts;
+      accounts.reserve( account_count );
+
+      db.with_write_lock( [&]()
+      {
+         for( uint32_t i = 0; i < account_count; ++i )
+         {
+            const auto& a = db.create< account_object >( [&]( account_object& a )
+            {
+               a.name = "bench" + std::to_string( i );
+            });
+            accounts.push_back( a.name );
+
+            db.create< token_balance_object >( [&]( token_balance_object& b )
+            {
+               b.account = a.name;
+               b.token = token;
+               b.balance = initial;
+               b.savings_balance = asset( 0, initial.symbol );
+            });
+         }
+      });
+
+      db.with_write_lock( [&]()
+      {
+         auto session = db.start_undo_session( true );
+         futurepia::token::util::token_util utils( db );
+
+         auto start = fc::time_point::now();
+         for( uint32_t i = 0; i < iterations; ++i )
+         {
+            utils.adjust_token_balance( accounts[ i % account_count ], token, -amount );
+            utils.adjust_token_balance( accounts[ ( i + 1 ) % account_count ], token, amount );
+         }
+         auto elapsed = fc::time_point::now() - start;
+
+         session.undo();
+
+         std::cout << "transfer_token: " << iterations << " transfers in " << elapsed.count() / 1000 << " ms, "
+                   << uint64_t( double( iterations ) * 1000000 / std::max< int64_t >( elapsed.count(), 1 ) ) << " transfers/s\n";
+      });
+
+      db.close();
+   }
+   catch( const fc::exception& e )
+   {
+      std::cerr << e.to_detail_string() << "\n";
+      return 1;
+   }
+   return 0;
+}